@@ -6,7 +6,7 @@ set WarningFlags=/W4 /wd4100 /wd4201 /wd4505 /wd4706 /WX
 set OptionFlags=-DCOMPILE_WIN32=1
 set LinkerFlags=/link /INCREMENTAL:NO /OPT:REF user32.lib Gdi32.lib
 
-set BuildFlags=/FC /fp:fast /GL /GR- /Gw /nologo /Oi
+set BuildFlags=/FC /fp:fast /GL /GR- /Gw /nologo /Oi /constexpr:steps10000000
 set DebugFlags=/Od /Zi
 set OptimizedFlags=/O2
 
@@ -16,4 +16,6 @@ REM set CompilerFlags=%BuildFlags% %OptimizedFlags% %WarningFlags% %OptionFlags%
 IF NOT EXIST %~dp0\..\build mkdir %~dp0\..\build
 pushd %~dp0\..\build
 cl %CompilerFlags% %~dp0\win32_paths.cpp %LinkerFlags%
+cl %CompilerFlags% %~dp0\win32_paths_export.cpp %LinkerFlags%
+win32_paths_export.exe -verifybaked || (popd & exit /b 1)
 popd
\ No newline at end of file
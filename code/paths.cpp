@@ -0,0 +1,702 @@
+internal constexpr u32
+AdvanceRandomNumber(u32 Number)
+{
+    u32 Result = Number;
+    u32 Subtraction = (Number & 7187) * 941083981;
+    u32 Addition = (Number & 141650963) * 433024223;
+    Result += 23 + Addition - Subtraction;
+    return(Result);
+}
+
+internal constexpr game_tile*
+GetRoomTile(game_room *Room, int X, int Y)
+{
+    game_tile *Tile = (Room->Tiles + X + Y * Room->Width);
+    return(Tile);
+}
+
+internal constexpr b32
+IsRoomTileFree(game_room *Room, int X, int Y)
+{
+    b32 Result = false;
+    int Height = Room->Height;
+    int Width = Room->Width;
+    
+    if(X >= 0 && Y >= 0 && X < Width && Y < Height)
+    {
+        game_tile *Tile = GetRoomTile(Room, X, Y);
+        Result = Tile->IsFree;
+    }
+    return(Result);
+}
+
+internal game_tile*
+GetTile(game_state *GameState, int X, int Y)
+{
+    game_tile *Tile = GetRoomTile(&GameState->Room, X, Y);
+    return(Tile);
+}
+
+internal b32
+IsTileFree(game_state *GameState, int X, int Y)
+{
+    b32 Result = IsRoomTileFree(&GameState->Room, X, Y);
+    return(Result);
+}
+
+internal b32
+IsSolutionTile(game_state *GameState, int X, int Y)
+{
+    // NOTE(Zyonji): the start is not free, but the walk begins there with the player on it.
+    b32 Result = (IsTileFree(GameState, X, Y) || (X == GameState->X && Y == GameState->Y));
+    return(Result);
+}
+
+internal b32
+IsSolutionLink(game_state *GameState, game_tile *Tile, int RelativeX, int RelativeY)
+{
+    // NOTE(Zyonji): the ends of the path link to 0, 0 which is never free, so the link
+    // has to be checked from both sides to reach the exit, which only links back, and the
+    // start below the first path tile has to be joined by hand.
+    b32 Result = false;
+    int LinkX = Tile->X + RelativeX;
+    int LinkY = Tile->Y + RelativeY;
+    if(IsSolutionTile(GameState, LinkX, LinkY))
+    {
+        game_tile *Link = GetTile(GameState, LinkX, LinkY);
+        int StartX = GameState->Room.Width / 2;
+        Result = ((Tile->NextX == LinkX && Tile->NextY == LinkY) ||
+                  (Tile->PreviousX == LinkX && Tile->PreviousY == LinkY) ||
+                  (Link->NextX == Tile->X && Link->NextY == Tile->Y) ||
+                  (Link->PreviousX == Tile->X && Link->PreviousY == Tile->Y) ||
+                  (Tile->X == StartX && LinkX == StartX && Tile->Y + LinkY == 1));
+    }
+    return(Result);
+}
+
+internal b32
+IsSolutionPixel(game_state *GameState, int TileX, int TileY, int SubX, int SubY)
+{
+    b32 Result = false;
+    int Center = (GameState->Buffer.TileOffset + 1) / 2;
+    if((SubX == Center || SubY == Center) && IsSolutionTile(GameState, TileX, TileY))
+    {
+        game_tile *Tile = GetTile(GameState, TileX, TileY);
+        if(SubX == Center && SubY == Center)
+        {
+            Result = true;
+        }
+        else if(SubY == Center)
+        {
+            Result = IsSolutionLink(GameState, Tile, (SubX < Center) ? -1 : 1, 0);
+        }
+        else
+        {
+            Result = IsSolutionLink(GameState, Tile, 0, (SubY < Center) ? -1 : 1);
+        }
+    }
+    return(Result);
+}
+
+internal void
+RedrawRoom(game_state *GameState)
+{
+    win32_offscreen_buffer *Buffer = &GameState->Buffer;
+    
+    u8 *PixelRow = (u8 *)Buffer->Memory;
+    int TileY = 0;
+    int SubY = 0;
+    for(int Y = 0;
+        Y < Buffer->Height;
+        ++Y)
+    {
+        u32 *Pixel = (u32 *)PixelRow;
+        int TileX = 0;
+        int SubX = 0;
+        for(int X = 0;
+            X < Buffer->Width;
+            ++X)
+        {
+            game_tile *Tile = GetTile(GameState, TileX, TileY);
+            if(GameState->ShowSolution && IsSolutionPixel(GameState, TileX, TileY, SubX, SubY))
+            {
+                *Pixel++ = Buffer->SolutionColor;
+            }
+            else if(SubX == 0 || SubY == 0)
+            {
+                *Pixel++ = Buffer->BorderColor;
+            }
+            else if(TileX == GameState->X && TileY == GameState->Y)
+            {
+                if(GameState->Doomed)
+                {
+                    if((X & 1) == (Y & 1))
+                    {
+                        *Pixel++ = 0x008F2F2F;
+                    }
+                    else
+                    {
+                        *Pixel++ = 0x00AF4F4F;
+                    }
+                }
+                else if((X & 1) == (Y & 1))
+                {
+                    *Pixel++ = 0x006F6F6F;
+                }
+                else
+                {
+                    *Pixel++ = 0x008F8F8F;
+                }
+            }
+            else if(Tile->IsFree)
+            {
+                *Pixel++ = Buffer->FreeColor;
+            }
+            else
+            {
+                *Pixel++ = Buffer->CheckedColor;
+            }
+            
+            if(++SubX == Buffer->TileOffset)
+            {
+                SubX = 0;
+                ++TileX;
+            }
+        }
+        if(++SubY == Buffer->TileOffset)
+        {
+            SubY = 0;
+            ++TileY;
+        }
+        PixelRow += Buffer->Pitch;
+    }
+}
+
+internal u32
+ComputeColor(r32 Value, u32 Continuum)
+{
+    u32 Result;
+    r32 Red;
+    r32 Green;
+    r32 Blue;
+    u32 Spectrum = Continuum % 600;
+    if(Spectrum < 100)
+    {
+        Red = 1.0f;
+        Green = Spectrum / 100.0f;
+        Blue = 0.0f;
+    }
+    else if(Spectrum < 200)
+    {
+        Red = (Spectrum - 100) / 100.0f;
+        Green = 1.0f;
+        Blue = 0.0f;
+    }
+    else if(Spectrum < 300)
+    {
+        Red = 0.0f;
+        Green = 1.0f;
+        Blue = (Spectrum - 200) / 100.0f;
+    }
+    else if(Spectrum < 400)
+    {
+        Red = 0.0f;
+        Green = (Spectrum - 300) / 100.0f;
+        Blue = 1.0f;
+    }
+    else if(Spectrum < 500)
+    {
+        Red = (Spectrum - 400) / 100.0f;
+        Green = 0.0f;
+        Blue = 1.0f;
+    }
+    else
+    {
+        Red = 1.0f;
+        Green = 0.0f;
+        Blue = (Spectrum - 500) / 100.0f;
+    }
+    Result = ((u32)(Red * Value) << 16) + ((u32)(Green * Value) << 8) + ((u32)(Blue * Value) << 0);
+    return(Result);
+}
+
+internal constexpr room_size
+GetRoomSize(u32 RoomsCleared)
+{
+    room_size Result = {};
+    r32 Factor = 1.0f + RoomsCleared;
+    int TileWidth = 5;
+    int TileSpace = 1;
+    Result.Height = (int)(4.5f + 96.0f * Factor / (Factor + 200.0f));
+    Result.Width = (int)(1.5f * Result.Height);
+    Result.TileOffset = TileWidth + TileSpace;
+    Result.PixelWidth = Result.Width * Result.TileOffset + TileSpace;
+    Result.PixelHeight = Result.Height * Result.TileOffset + TileSpace;
+    return(Result);
+}
+
+internal constexpr void
+GenerateRoom(game_room *Room, u32 Seed)
+{
+    int Height = Room->Height;
+    int Width = Room->Width;
+    int StartX = Width / 2;
+    int StartY = 0;
+    
+    game_tile *TileRow = Room->Tiles;
+    for(int Y = 0;
+        Y < Height;
+        ++Y)
+    {
+        game_tile *Tile = TileRow;
+        for(int X = 0;
+            X < Width;
+            ++X)
+        {
+            Tile->X = X;
+            Tile->Y = Y;
+            if(X == StartX && Y != StartY)
+            {
+                Tile->IsFree = true;
+                if(Y > 1)
+                {
+                    Tile->PreviousX = X;
+                    Tile->PreviousY = Y - 1;
+                }
+                else
+                {
+                    Tile->PreviousX = 0;
+                    Tile->PreviousY = 0;
+                }
+                if(Y < Height - 2)
+                {
+                    Tile->NextX = X;
+                    Tile->NextY = Y + 1;
+                }
+                else
+                {
+                    Tile->NextX = 0;
+                    Tile->NextY = 0;
+                }
+            }
+            else
+            {
+                Tile->IsFree = false;
+            }
+            ++Tile;
+        }
+        
+        TileRow += Width;
+    }
+    
+    u32 Random = AdvanceRandomNumber(Seed);
+    int RemainingTiles = (Height - 2) * (Width - 1);
+    int MinimumHoles = RemainingTiles / 8;
+    game_tile *FirstTile = Room->Tiles + Width - 1;
+    for(int I = 0;
+        I < 10 && RemainingTiles > MinimumHoles;
+        ++I)
+    {
+        int TileNumber = Random % RemainingTiles;
+        game_tile *Tile = FirstTile;
+        for(int J = 0;
+            J <= TileNumber;
+            J)
+        {
+            ++Tile;
+            if(!Tile->IsFree)
+            {
+                ++J;
+            }
+        }
+        Random = AdvanceRandomNumber(Random);
+        b32 MovedPath = false;
+        int Stretch = (Random & 0x7) + 2;
+        int Orientation = (Random & 0x30) / 0x10;
+        int X = Tile->X;
+        int Y = Tile->Y;
+        for(int J = 0;
+            J < 4 && !MovedPath;
+            ++J)
+        {
+            // NOTE(Zyonji): extending forward, pulling left
+            int dX = 0;
+            int dY = 0;
+            if(Orientation & 0x1)
+            {
+                if(Orientation & 0x2)
+                {
+                    dX = 1;
+                }
+                else
+                {
+                    dX = -1;
+                }
+            }
+            else
+            {
+                if(Orientation & 0x2)
+                {
+                    dY = 1;
+                }
+                else
+                {
+                    dY = -1;
+                }
+            }
+            
+            int TestX = X + dX;
+            int TestY = Y + dY;
+            game_tile *TestTile = GetRoomTile(Room, TestX, TestY);
+            while(TestX >= 0 && TestY > 0 && TestX < Width && TestY < Height - 1 && !TestTile->IsFree)
+            {
+                TestX += dX;
+                TestY += dY;
+                TestTile = GetRoomTile(Room, TestX, TestY);
+            }
+            if(TestX >= 0 && TestY > 0 && TestX < Width && TestY < Height - 1)
+            {
+                // NOTE(Zyonji): found path
+                int PathLength = 1;
+                while(((TestTile->NextX == TestX && dY == 0) || 
+                       (TestTile->NextY == TestY && dX == 0)) && PathLength <= Stretch)
+                {
+                    int PathX = TestTile->NextX - dX;
+                    int PathY = TestTile->NextY - dY;
+                    while(PathX != X && PathY != Y && !IsRoomTileFree(Room, PathX, PathY))
+                    {
+                        PathX -= dX;
+                        PathY -= dY;
+                    }
+                    if(IsRoomTileFree(Room, PathX, PathY))
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        TestX = TestTile->NextX;
+                        TestY = TestTile->NextY;
+                        TestTile = GetRoomTile(Room, TestX, TestY);
+                    }
+                    ++PathLength;
+                }
+                
+                if(TestX != X && TestY != Y)
+                {
+                    int PathX = TestX;
+                    int PathY = TestY;
+                    game_tile *PathTile = GetRoomTile(Room, PathX, PathY);
+                    game_tile *OldTile = GetRoomTile(Room, PathTile->PreviousX, PathTile->PreviousY);
+                    PathX -= dX;
+                    PathY -= dY;
+                    PathTile->PreviousX = PathX;
+                    PathTile->PreviousY = PathY;
+                    PathTile = GetRoomTile(Room, PathX, PathY);
+                    while(PathX != X && PathY != Y)
+                    {
+                        PathTile->NextX = PathX + dX;
+                        PathTile->NextY = PathY + dY;
+                        PathX -= dX;
+                        PathY -= dY;
+                        PathTile->PreviousX = PathX;
+                        PathTile->PreviousY = PathY;
+                        PathTile->IsFree = true;
+                        --RemainingTiles;
+                        PathTile = GetRoomTile(Room, PathX, PathY);
+                    }
+                    int dX2 = 0;
+                    int dY2 = 0;
+                    if(PathX == X)
+                    {
+                        dY2 = OldTile->NextY - OldTile->Y;
+                    }
+                    if(PathY == Y)
+                    {
+                        dX2 = OldTile->NextX - OldTile->X;
+                    }
+                    PathTile->NextX = PathX + dX;
+                    PathTile->NextY = PathY + dY;
+                    PathX -= dX2;
+                    PathY -= dY2;
+                    PathTile->PreviousX = PathX;
+                    PathTile->PreviousY = PathY;
+                    PathTile->IsFree = true;
+                    --RemainingTiles;
+                    PathTile = GetRoomTile(Room, PathX, PathY);
+                    while(OldTile->X != X && OldTile->Y != Y)
+                    {
+                        PathTile->NextX = PathX + dX2;
+                        PathTile->NextY = PathY + dY2;
+                        PathX -= dX2;
+                        PathY -= dY2;
+                        PathTile->PreviousX = PathX;
+                        PathTile->PreviousY = PathY;
+                        PathTile->IsFree = true;
+                        PathTile = GetRoomTile(Room, PathX, PathY);
+                        OldTile->IsFree = false;
+                        OldTile = GetRoomTile(Room, OldTile->PreviousX, OldTile->PreviousY);
+                    }
+                    PathTile->NextX = PathX + dX2;
+                    PathTile->NextY = PathY + dY2;
+                    PathX += dX;
+                    PathY += dY;
+                    PathTile->PreviousX = PathX;
+                    PathTile->PreviousY = PathY;
+                    PathTile->IsFree = true;
+                    --RemainingTiles;
+                    PathTile = GetRoomTile(Room, PathX, PathY);
+                    while(PathX != TestX && PathY != TestY)
+                    {
+                        PathTile->NextX = PathX - dX;
+                        PathTile->NextY = PathY - dY;
+                        PathX += dX;
+                        PathY += dY;
+                        PathTile->PreviousX = PathX;
+                        PathTile->PreviousY = PathY;
+                        PathTile->IsFree = true;
+                        --RemainingTiles;
+                        PathTile = GetRoomTile(Room, PathX, PathY);
+                    }
+                    PathTile->NextX = PathX - dX;
+                    PathTile->NextY = PathY - dY;
+                    I = 0;
+                    break;
+                }
+            }
+            ++Orientation;
+        }
+        Random = AdvanceRandomNumber(Random);
+    }
+}
+
+#include "paths_baked.cpp"
+
+internal b32
+IsTileOpen(game_state *GameState, int X, int Y)
+{
+    // NOTE(Zyonji): the tiles that are left to walk, counting the one the player stands on.
+    b32 Result = (IsTileFree(GameState, X, Y) || (X == GameState->X && Y == GameState->Y));
+    return(Result);
+}
+
+internal b32
+IsDeadEnd(game_state *GameState, game_tile *Tile)
+{
+    // NOTE(Zyonji): only the exit may be the end of the remaining path.
+    b32 Result = (Tile->OpenNeighbors < 2 &&
+                  !(Tile->X == GameState->X && Tile->Y == GameState->Y) &&
+                  !(Tile->X == GameState->Room.Width / 2 && Tile->Y == GameState->Room.Height - 1));
+    return(Result);
+}
+
+internal i32
+FindBlockedRoot(game_state *GameState, int X, int Y)
+{
+    // NOTE(Zyonji): everything outside of the room belongs to the corner tile, which is
+    // never free.
+    game_room *Room = &GameState->Room;
+    i32 Index = 0;
+    if(X >= 0 && Y >= 0 && X < Room->Width && Y < Room->Height)
+    {
+        Index = X + Y * Room->Width;
+    }
+    while(Room->Tiles[Index].BlockedParent != Index)
+    {
+        game_tile *Tile = Room->Tiles + Index;
+        Tile->BlockedParent = Room->Tiles[Tile->BlockedParent].BlockedParent;
+        Index = Tile->BlockedParent;
+    }
+    return(Index);
+}
+
+internal void
+JoinBlockedTiles(game_state *GameState, int X, int Y)
+{
+    i32 Root = FindBlockedRoot(GameState, X, Y);
+    for(int dY = -1;
+        dY <= 1;
+        ++dY)
+    {
+        for(int dX = -1;
+            dX <= 1;
+            ++dX)
+        {
+            if((dX || dY) && !IsTileOpen(GameState, X + dX, Y + dY))
+            {
+                i32 Other = FindBlockedRoot(GameState, X + dX, Y + dY);
+                GameState->Room.Tiles[Other].BlockedParent = Root;
+            }
+        }
+    }
+}
+
+internal b32
+DoesBlockingSplitRoom(game_state *GameState, int X, int Y)
+{
+    // NOTE(Zyonji): The open tiles connect along edges and the blocked ones along corners
+    // as well, so one can only be cut apart by closing a loop of the other. The open
+    // neighbors of the tile fall into groups with a blocked gap between each of them.
+    // Blocking the tile joins those gaps, and every gap that already belongs to the same
+    // blocked area as another one encloses a group.
+    local_persist int RingX[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    local_persist int RingY[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+    b32 Open[8];
+    for(int I = 0;
+        I < 8;
+        ++I)
+    {
+        Open[I] = IsTileOpen(GameState, X + RingX[I], Y + RingY[I]);
+    }
+    
+    i32 Gaps[4];
+    int GapCount = 0;
+    for(int I = 0;
+        I < 8;
+        I += 2)
+    {
+        int Previous = (I + 6) & 7;
+        int Corner = (I + 7) & 7;
+        if(Open[I] && !(Open[Previous] && Open[Corner]))
+        {
+            int Gap = Open[Corner] ? Previous : Corner;
+            Gaps[GapCount++] = FindBlockedRoot(GameState, X + RingX[Gap], Y + RingY[Gap]);
+        }
+    }
+    
+    int BlockedAreas = 0;
+    for(int I = 0;
+        I < GapCount;
+        ++I)
+    {
+        b32 IsNew = true;
+        for(int J = 0;
+            J < I;
+            ++J)
+        {
+            IsNew &= (Gaps[I] != Gaps[J]);
+        }
+        BlockedAreas += IsNew;
+    }
+    return(GapCount > BlockedAreas);
+}
+
+internal void
+BeginRoomChecks(game_state *GameState)
+{
+    game_room *Room = &GameState->Room;
+    GameState->Doomed = false;
+    GameState->DeadEnds = 0;
+    for(int I = 0;
+        I < Room->Width * Room->Height;
+        ++I)
+    {
+        Room->Tiles[I].BlockedParent = I;
+    }
+    
+    game_tile *Tile = Room->Tiles;
+    for(int Y = 0;
+        Y < Room->Height;
+        ++Y)
+    {
+        for(int X = 0;
+            X < Room->Width;
+            ++X)
+        {
+            if(IsTileOpen(GameState, X, Y))
+            {
+                Tile->OpenNeighbors = (IsTileOpen(GameState, X + 1, Y) + IsTileOpen(GameState, X - 1, Y) +
+                                       IsTileOpen(GameState, X, Y + 1) + IsTileOpen(GameState, X, Y - 1));
+                if(IsDeadEnd(GameState, Tile))
+                {
+                    ++GameState->DeadEnds;
+                }
+            }
+            else
+            {
+                JoinBlockedTiles(GameState, X, Y);
+            }
+            ++Tile;
+        }
+    }
+}
+
+internal void
+UpdateRoomChecks(game_state *GameState, int OldX, int OldY)
+{
+    // NOTE(Zyonji): called after the player left OldX, OldY. Only its neighbors change.
+    game_tile *Player = GetTile(GameState, GameState->X, GameState->Y);
+    if(Player->OpenNeighbors < 2 &&
+       !(Player->X == GameState->Room.Width / 2 && Player->Y == GameState->Room.Height - 1))
+    {
+        --GameState->DeadEnds;
+    }
+    
+    int NeighborX[4] = {OldX + 1, OldX - 1, OldX, OldX};
+    int NeighborY[4] = {OldY, OldY, OldY + 1, OldY - 1};
+    for(int I = 0;
+        I < 4;
+        ++I)
+    {
+        if(IsTileOpen(GameState, NeighborX[I], NeighborY[I]))
+        {
+            game_tile *Tile = GetTile(GameState, NeighborX[I], NeighborY[I]);
+            if(--Tile->OpenNeighbors == 1 && IsDeadEnd(GameState, Tile))
+            {
+                ++GameState->DeadEnds;
+            }
+        }
+    }
+    
+    b32 Splits = DoesBlockingSplitRoom(GameState, OldX, OldY);
+    JoinBlockedTiles(GameState, OldX, OldY);
+    if(Splits || GameState->DeadEnds > 0)
+    {
+        GameState->Doomed = true;
+    }
+}
+
+internal void
+ResetRoom(game_state *GameState)
+{
+    r32 Factor = 1.0f + GameState->RoomsCleared;
+    room_size Size = GetRoomSize(GameState->RoomsCleared);
+    int Height = Size.Height;
+    int Width = Size.Width;
+    GameState->X = Width / 2;
+    GameState->Y = 0;
+    
+    game_room *Room = &GameState->Room;
+    Room->Height = Height;
+    Room->Width = Width;
+    Room->Tiles = (game_tile *)(GameState + 1);
+    
+    if(!UnpackBakedRoom(Room, GameState->Seed, GameState->RoomsCleared))
+    {
+        GenerateRoom(Room, GameState->Seed);
+    }
+    
+    win32_offscreen_buffer *Buffer = &GameState->Buffer;
+    int BytesPerPixel = 4;
+    Buffer->Width = Size.PixelWidth;
+    Buffer->Height = Size.PixelHeight;
+    Buffer->BytesPerPixel = BytesPerPixel;
+    Buffer->Pitch = (Buffer->Width * BytesPerPixel + 15) & ~15;
+    Buffer->TileOffset = Size.TileOffset;
+    Buffer->Memory = (void *)(Room->Tiles + Height * Width);
+    
+    Buffer->FreeColor = 0x00FFFFFF;
+    r32 Value = 256.0f * Factor / (Factor + 255.0f);
+    Buffer->CheckedColor = ComputeColor(Value, GameState->RoomsCleared);
+    Buffer->BorderColor = ComputeColor(Value, GameState->RoomsCleared + GameState->RoomsCleared / 10);
+    Buffer->SolutionColor = ComputeColor(Value, GameState->RoomsCleared + 300);
+    
+    Buffer->Info.bmiHeader.biSize = sizeof(Buffer->Info.bmiHeader);
+    Buffer->Info.bmiHeader.biWidth = Buffer->Pitch / BytesPerPixel;
+    Buffer->Info.bmiHeader.biHeight = Buffer->Height;
+    Buffer->Info.bmiHeader.biPlanes = 1;
+    Buffer->Info.bmiHeader.biBitCount = 32;
+    Buffer->Info.bmiHeader.biCompression = BI_RGB;
+    
+    BeginRoomChecks(GameState);
+    RedrawRoom(GameState);
+}
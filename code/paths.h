@@ -0,0 +1,83 @@
+#include <stdint.h>
+#include <stddef.h>
+
+#define internal static
+#define local_persist static
+#define global_variable static
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+typedef i32 b32;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef size_t memory_index;
+
+typedef float r32;
+typedef double r64;
+
+#define PATHS_FIRST_SEED 420023
+
+struct win32_offscreen_buffer
+{
+    BITMAPINFO Info;
+    void *Memory;
+    i32 Width;
+    i32 Height;
+    i32 Pitch;
+    i32 BytesPerPixel;
+    
+    i32 TileOffset;
+    u32 FreeColor;
+    u32 CheckedColor;
+    u32 BorderColor;
+    u32 SolutionColor;
+};
+
+struct game_tile
+{
+    b32 IsFree;
+    i32 X;
+    i32 Y;
+    i32 PreviousX;
+    i32 PreviousY;
+    i32 NextX;
+    i32 NextY;
+    i32 OpenNeighbors;
+    i32 BlockedParent;
+};
+
+struct game_room
+{
+    i32 Width;
+    i32 Height;
+    game_tile *Tiles;
+};
+
+struct room_size
+{
+    i32 Width;
+    i32 Height;
+    i32 TileOffset;
+    i32 PixelWidth;
+    i32 PixelHeight;
+};
+
+struct game_state
+{
+    b32 Running;
+    b32 ShowSolution;
+    b32 Doomed;
+    i32 DeadEnds;
+    u32 Seed;
+    u32 RoomsCleared;
+    i32 X;
+    i32 Y;
+    game_room Room;
+    win32_offscreen_buffer Buffer;
+};
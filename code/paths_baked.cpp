@@ -0,0 +1,181 @@
+// NOTE(Zyonji): The first rooms of the default seed chain are generated at compile time,
+// so starting the game and the first transitions only copy a table. build.bat runs
+// win32_paths_export -verifybaked to fail the build if they ever differ from the runtime.
+#ifndef PATHS_BAKED_ROOMS
+#define PATHS_BAKED_ROOMS 16
+#endif
+
+#define BAKED_TILE_FREE 0x01
+#define BAKED_TILE_NEXT_SHIFT 1
+#define BAKED_TILE_PREVIOUS_SHIFT 4
+#define BAKED_LINK_PRESENT 0x1
+
+global_variable constexpr room_size BakedMaxSize = GetRoomSize(PATHS_BAKED_ROOMS - 1);
+global_variable constexpr i32 BakedDirectionX[4] = {1, 0, -1, 0};
+global_variable constexpr i32 BakedDirectionY[4] = {0, 1, 0, -1};
+
+static_assert(BakedMaxSize.Width < 256 && BakedMaxSize.Height < 256, "Baked rooms store their size in a byte.");
+
+struct baked_room
+{
+    u32 Seed;
+    u8 Width;
+    u8 Height;
+    // NOTE(Zyonji): bit 0 is IsFree, bits 1-3 and 4-6 hold the next and previous link as a
+    // present bit and a direction. Links that are not to a neighbor are stored as 0, 0.
+    u8 Tiles[BakedMaxSize.Width * BakedMaxSize.Height];
+};
+
+struct baked_rooms
+{
+    baked_room Rooms[PATHS_BAKED_ROOMS];
+};
+
+internal constexpr u8
+PackTileLink(game_tile *Tile, i32 LinkX, i32 LinkY)
+{
+    u8 Result = 0;
+    for(int Direction = 0;
+        Direction < 4;
+        ++Direction)
+    {
+        if(Tile->X + BakedDirectionX[Direction] == LinkX && Tile->Y + BakedDirectionY[Direction] == LinkY)
+        {
+            Result = (u8)(BAKED_LINK_PRESENT | (Direction << 1));
+        }
+    }
+    return(Result);
+}
+
+internal constexpr void
+UnpackTileLink(game_tile *Tile, u8 Link, i32 *LinkX, i32 *LinkY)
+{
+    *LinkX = 0;
+    *LinkY = 0;
+    if(Link & BAKED_LINK_PRESENT)
+    {
+        int Direction = (Link >> 1) & 0x3;
+        *LinkX = Tile->X + BakedDirectionX[Direction];
+        *LinkY = Tile->Y + BakedDirectionY[Direction];
+    }
+}
+
+internal constexpr baked_rooms
+BakeRooms()
+{
+    baked_rooms Result = {};
+    game_tile Tiles[BakedMaxSize.Width * BakedMaxSize.Height] = {};
+    u32 Seed = PATHS_FIRST_SEED;
+    for(u32 RoomsCleared = 0;
+        RoomsCleared < PATHS_BAKED_ROOMS;
+        ++RoomsCleared)
+    {
+        if(RoomsCleared)
+        {
+            Seed = AdvanceRandomNumber(Seed + RoomsCleared);
+        }
+        room_size Size = GetRoomSize(RoomsCleared);
+        game_room Room = {Size.Width, Size.Height, Tiles};
+        GenerateRoom(&Room, Seed);
+
+        baked_room *Baked = Result.Rooms + RoomsCleared;
+        Baked->Seed = Seed;
+        Baked->Width = (u8)Size.Width;
+        Baked->Height = (u8)Size.Height;
+        for(int I = 0;
+            I < Size.Width * Size.Height;
+            ++I)
+        {
+            game_tile *Tile = Tiles + I;
+            if(Tile->IsFree)
+            {
+                Baked->Tiles[I] = (u8)(BAKED_TILE_FREE |
+                                       (PackTileLink(Tile, Tile->NextX, Tile->NextY) << BAKED_TILE_NEXT_SHIFT) |
+                                       (PackTileLink(Tile, Tile->PreviousX, Tile->PreviousY) << BAKED_TILE_PREVIOUS_SHIFT));
+            }
+        }
+    }
+    return(Result);
+}
+
+global_variable constexpr baked_rooms BakedRooms = BakeRooms();
+
+internal constexpr b32
+AreBakedRoomsSolvable()
+{
+    // NOTE(Zyonji): the stored path has to lead from above the player to below the exit
+    // and visit every other free tile on the way.
+    b32 Result = true;
+    for(int RoomIndex = 0;
+        RoomIndex < PATHS_BAKED_ROOMS;
+        ++RoomIndex)
+    {
+        const baked_room *Baked = BakedRooms.Rooms + RoomIndex;
+        int FreeTiles = 0;
+        for(int I = 0;
+            I < Baked->Width * Baked->Height;
+            ++I)
+        {
+            if(Baked->Tiles[I] & BAKED_TILE_FREE)
+            {
+                ++FreeTiles;
+            }
+        }
+
+        int X = Baked->Width / 2;
+        int Y = 1;
+        int PathTiles = 1;
+        u8 Tile = Baked->Tiles[X + Y * Baked->Width];
+        while(PathTiles <= FreeTiles && ((Tile >> BAKED_TILE_NEXT_SHIFT) & BAKED_LINK_PRESENT))
+        {
+            int Direction = (Tile >> (BAKED_TILE_NEXT_SHIFT + 1)) & 0x3;
+            X += BakedDirectionX[Direction];
+            Y += BakedDirectionY[Direction];
+            Tile = Baked->Tiles[X + Y * Baked->Width];
+            ++PathTiles;
+        }
+        u8 Exit = Baked->Tiles[Baked->Width / 2 + (Baked->Height - 1) * Baked->Width];
+        if(!(Tile & BAKED_TILE_FREE) || !(Exit & BAKED_TILE_FREE) ||
+           X != Baked->Width / 2 || Y != Baked->Height - 2 || PathTiles + 1 != FreeTiles)
+        {
+            Result = false;
+        }
+    }
+    return(Result);
+}
+
+static_assert(AreBakedRoomsSolvable(), "A baked room does not contain its own solution.");
+
+internal b32
+UnpackBakedRoom(game_room *Room, u32 Seed, u32 RoomsCleared)
+{
+    b32 Result = false;
+    if(RoomsCleared < PATHS_BAKED_ROOMS)
+    {
+        const baked_room *Baked = BakedRooms.Rooms + RoomsCleared;
+        if(Baked->Seed == Seed && Baked->Width == Room->Width && Baked->Height == Room->Height)
+        {
+            game_tile *Tile = Room->Tiles;
+            const u8 *BakedTile = Baked->Tiles;
+            for(int Y = 0;
+                Y < Room->Height;
+                ++Y)
+            {
+                for(int X = 0;
+                    X < Room->Width;
+                    ++X)
+                {
+                    Tile->X = X;
+                    Tile->Y = Y;
+                    Tile->IsFree = (*BakedTile & BAKED_TILE_FREE);
+                    UnpackTileLink(Tile, (u8)(*BakedTile >> BAKED_TILE_NEXT_SHIFT), &Tile->NextX, &Tile->NextY);
+                    UnpackTileLink(Tile, (u8)(*BakedTile >> BAKED_TILE_PREVIOUS_SHIFT), &Tile->PreviousX, &Tile->PreviousY);
+                    ++Tile;
+                    ++BakedTile;
+                }
+            }
+            Result = true;
+        }
+    }
+    return(Result);
+}
@@ -0,0 +1,718 @@
+// NOTE(Zyonji): Counts the ways to step on every free tile once, from the start below the
+// room to the exit above it. The player has to enter at the tile above the start and leave
+// through the tile below the exit, so those two are path ends and all other free tiles are
+// passed through. The count runs a plug dynamic program over the tiles between them, one
+// cell at a time. The frontier holds one plug per edge crossing it: none, the left or right
+// end of a path piece (matched like brackets), or a piece that is already attached to one
+// of the two path ends. The frontier runs along the shorter side of the room.
+//
+// The states of every step are spread over PartitionCount hash tables. Expanding a source
+// partition and merging into a target partition only touch their own memory, so the
+// platform layer can run all partitions of a phase in parallel. Each target table takes
+// its share of one arena sized from the transitions that reach it, so MaxStates limits
+// the states of a step in total, whatever the number of partitions:
+//
+//     BeginSolutionCount
+//     do
+//     {
+//         ExpandSolutionPartition for every partition
+//         MergeSolutionPartition for every partition
+//     } while(AdvanceSolutionCount)
+//     EndSolutionCount
+
+#ifndef SOLUTION_COUNT_LIMBS
+#define SOLUTION_COUNT_LIMBS 2
+#endif
+
+#define FRONTIER_KEY_WORDS 4
+#define MAX_SOLUTION_PARTITIONS 64
+// NOTE(Zyonji): keeps the 8 * MaxStates table slots of a step in a u32.
+#define MAX_SOLUTION_STATES (1u << 28)
+
+#define PLUG_NONE 0
+#define PLUG_OPEN 1
+#define PLUG_CLOSE 2
+#define PLUG_END 3
+
+struct solution_count
+{
+    u64 Limbs[SOLUTION_COUNT_LIMBS];
+};
+
+struct frontier_key
+{
+    u64 Words[FRONTIER_KEY_WORDS];
+};
+
+struct frontier_table
+{
+    u32 Count;
+    u32 Capacity;
+    // NOTE(Zyonji): Hashes and Indices are the slots, Keys and Counts hold the states in
+    // the order they were inserted.
+    u32 *Hashes;
+    u32 *Indices;
+    frontier_key *Keys;
+    solution_count *Counts;
+};
+
+struct frontier_tables
+{
+    frontier_table Tables[MAX_SOLUTION_PARTITIONS];
+    u32 *Hashes;
+    u32 *Indices;
+    frontier_key *Keys;
+    solution_count *Counts;
+};
+
+struct frontier_transition
+{
+    frontier_key Key;
+    u32 Hash;
+    u32 Source;
+};
+
+struct frontier_transitions
+{
+    frontier_transition *Transitions;
+    u32 Offsets[MAX_SOLUTION_PARTITIONS + 1];
+};
+
+enum solution_count_status
+{
+    SolutionCount_Counted,
+    SolutionCount_Overflowed,
+    SolutionCount_TooManyStates,
+    SolutionCount_TooWide,
+};
+
+struct solution_counter
+{
+    game_room *Room;
+    b32 Transposed;
+    i32 Rows;
+    i32 Columns;
+    i32 Row;
+    i32 Column;
+
+    u32 PartitionCount;
+    u32 MaxStates;
+    frontier_tables *Source;
+    frontier_tables *Target;
+    frontier_transitions *Transitions;
+    frontier_transition *TransitionArena;
+
+    b32 TooManyStates;
+    b32 volatile Overflowed;
+};
+
+internal b32
+AddSolutionCount(solution_count *Sum, solution_count *Value)
+{
+    u64 Carry = 0;
+    for(int I = 0;
+        I < SOLUTION_COUNT_LIMBS;
+        ++I)
+    {
+        u64 Limb = Sum->Limbs[I] + Value->Limbs[I];
+        u64 NextCarry = (Limb < Value->Limbs[I]);
+        Limb += Carry;
+        NextCarry |= (Limb < Carry);
+        Sum->Limbs[I] = Limb;
+        Carry = NextCarry;
+    }
+    return(Carry != 0);
+}
+
+internal char *
+FormatSolutionCount(solution_count Count, char *Buffer)
+{
+    // NOTE(Zyonji): Buffer needs 20 characters per limb and one more, the digits end up at
+    // the end of it.
+    u32 Parts[2 * SOLUTION_COUNT_LIMBS];
+    for(int I = 0;
+        I < SOLUTION_COUNT_LIMBS;
+        ++I)
+    {
+        Parts[2 * I] = (u32)Count.Limbs[I];
+        Parts[2 * I + 1] = (u32)(Count.Limbs[I] >> 32);
+    }
+
+    char *At = Buffer + 20 * SOLUTION_COUNT_LIMBS + 1;
+    *--At = 0;
+    b32 IsZero = false;
+    while(!IsZero)
+    {
+        u64 Remainder = 0;
+        IsZero = true;
+        for(int I = 2 * SOLUTION_COUNT_LIMBS - 1;
+            I >= 0;
+            --I)
+        {
+            u64 Value = (Remainder << 32) | Parts[I];
+            Parts[I] = (u32)(Value / 1000000000);
+            Remainder = Value % 1000000000;
+            IsZero &= (Parts[I] == 0);
+        }
+        for(int Digit = 0;
+            Digit < 9 && (!IsZero || Remainder || Digit == 0);
+            ++Digit)
+        {
+            *--At = (char)('0' + Remainder % 10);
+            Remainder /= 10;
+        }
+    }
+    return(At);
+}
+
+internal u32
+GetPlug(frontier_key *Key, i32 Index)
+{
+    u32 Result = (u32)(Key->Words[Index >> 5] >> (2 * (Index & 31))) & 0x3;
+    return(Result);
+}
+
+internal void
+SetPlug(frontier_key *Key, i32 Index, u32 Plug)
+{
+    u64 *Word = Key->Words + (Index >> 5);
+    int Shift = 2 * (Index & 31);
+    *Word = (*Word & ~((u64)0x3 << Shift)) | ((u64)Plug << Shift);
+}
+
+internal b32
+IsFrontierEmpty(frontier_key *Key)
+{
+    u64 Bits = 0;
+    for(int I = 0;
+        I < FRONTIER_KEY_WORDS;
+        ++I)
+    {
+        Bits |= Key->Words[I];
+    }
+    return(Bits == 0);
+}
+
+internal b32
+AreFrontiersEqual(frontier_key *A, frontier_key *B)
+{
+    b32 Result = true;
+    for(int I = 0;
+        I < FRONTIER_KEY_WORDS;
+        ++I)
+    {
+        Result &= (A->Words[I] == B->Words[I]);
+    }
+    return(Result);
+}
+
+internal frontier_key
+ShiftFrontier(frontier_key Key)
+{
+    // NOTE(Zyonji): moves the plugs of a finished row under the cells of the next one.
+    frontier_key Result;
+    u64 Carry = 0;
+    for(int I = 0;
+        I < FRONTIER_KEY_WORDS;
+        ++I)
+    {
+        Result.Words[I] = (Key.Words[I] << 2) | Carry;
+        Carry = Key.Words[I] >> 62;
+    }
+    return(Result);
+}
+
+internal u32
+HashFrontier(frontier_key *Key)
+{
+    u64 Hash = 0x9E3779B97F4A7C15;
+    for(int I = 0;
+        I < FRONTIER_KEY_WORDS;
+        ++I)
+    {
+        Hash = (Hash ^ Key->Words[I]) * 0xFF51AFD7ED558CCD;
+        Hash ^= Hash >> 32;
+    }
+    // NOTE(Zyonji): a hash of 0 marks an empty slot.
+    u32 Result = (u32)Hash | 1;
+    return(Result);
+}
+
+internal u32
+GetHashPartition(solution_counter *Counter, u32 Hash)
+{
+    u32 Result = (u32)(((u64)Hash * Counter->PartitionCount) >> 32);
+    return(Result);
+}
+
+internal i32
+FindMatchingPlug(frontier_key *Key, i32 Index)
+{
+    u32 Plug = GetPlug(Key, Index);
+    u32 Partner = PLUG_OPEN + PLUG_CLOSE - Plug;
+    i32 Step = (Plug == PLUG_OPEN) ? 1 : -1;
+    i32 Depth = 0;
+    i32 Result = Index;
+    for(;;)
+    {
+        u32 Test = GetPlug(Key, Result);
+        if(Test == Plug)
+        {
+            ++Depth;
+        }
+        else if(Test == Partner && --Depth == 0)
+        {
+            break;
+        }
+        Result += Step;
+    }
+    return(Result);
+}
+
+internal game_tile *
+GetCounterTile(solution_counter *Counter, i32 Row, i32 Column)
+{
+    game_tile *Result = 0;
+    if(Row >= 0 && Column >= 0 && Row < Counter->Rows && Column < Counter->Columns)
+    {
+        if(Counter->Transposed)
+        {
+            Result = GetRoomTile(Counter->Room, Row, Column + 1);
+        }
+        else
+        {
+            Result = GetRoomTile(Counter->Room, Column, Row + 1);
+        }
+    }
+    return(Result);
+}
+
+internal b32
+IsCounterCellFree(solution_counter *Counter, i32 Row, i32 Column)
+{
+    game_tile *Tile = GetCounterTile(Counter, Row, Column);
+    b32 Result = (Tile && Tile->IsFree);
+    return(Result);
+}
+
+internal int
+GetCellTransitions(solution_counter *Counter, frontier_key Key, frontier_key *Out)
+{
+    int Count = 0;
+    i32 Row = Counter->Row;
+    i32 Column = Counter->Column;
+    if(Column == 0 && Row > 0)
+    {
+        Key = ShiftFrontier(Key);
+    }
+
+    u32 Left = GetPlug(&Key, Column);
+    u32 Up = GetPlug(&Key, Column + 1);
+    frontier_key Joined = Key;
+    SetPlug(&Joined, Column, PLUG_NONE);
+    SetPlug(&Joined, Column + 1, PLUG_NONE);
+
+    game_tile *Tile = GetCounterTile(Counter, Row, Column);
+    b32 CanGoDown = IsCounterCellFree(Counter, Row + 1, Column);
+    b32 CanGoRight = IsCounterCellFree(Counter, Row, Column + 1);
+    int Width = Counter->Room->Width;
+    int Height = Counter->Room->Height;
+    b32 IsPathEnd = (Tile->X == Width / 2 && (Tile->Y == 1 || Tile->Y == Height - 2));
+
+    if(!Tile->IsFree)
+    {
+        if(!Left && !Up)
+        {
+            Out[Count++] = Key;
+        }
+    }
+    else if(!Left && !Up)
+    {
+        u32 Down = IsPathEnd ? PLUG_END : PLUG_OPEN;
+        u32 Right = IsPathEnd ? PLUG_END : PLUG_CLOSE;
+        if(IsPathEnd && CanGoDown)
+        {
+            Out[Count] = Key;
+            SetPlug(Out + Count++, Column, Down);
+        }
+        if(IsPathEnd && CanGoRight)
+        {
+            Out[Count] = Key;
+            SetPlug(Out + Count++, Column + 1, Right);
+        }
+        if(!IsPathEnd && CanGoDown && CanGoRight)
+        {
+            Out[Count] = Key;
+            SetPlug(Out + Count, Column, Down);
+            SetPlug(Out + Count++, Column + 1, Right);
+        }
+    }
+    else if(!Left || !Up)
+    {
+        u32 Plug = Left | Up;
+        if(IsPathEnd)
+        {
+            // NOTE(Zyonji): a piece ends here, its other end becomes attached to this one.
+            if(Plug == PLUG_END)
+            {
+                if(IsFrontierEmpty(&Joined))
+                {
+                    Out[Count++] = Joined;
+                }
+            }
+            else
+            {
+                Out[Count] = Joined;
+                SetPlug(Out + Count++, FindMatchingPlug(&Key, Left ? Column : Column + 1), PLUG_END);
+            }
+        }
+        else
+        {
+            if(CanGoDown)
+            {
+                Out[Count] = Joined;
+                SetPlug(Out + Count++, Column, Plug);
+            }
+            if(CanGoRight)
+            {
+                Out[Count] = Joined;
+                SetPlug(Out + Count++, Column + 1, Plug);
+            }
+        }
+    }
+    else if(!IsPathEnd)
+    {
+        if(Left == PLUG_CLOSE && Up == PLUG_OPEN)
+        {
+            Out[Count++] = Joined;
+        }
+        else if(Left == PLUG_OPEN && Up == PLUG_OPEN)
+        {
+            Out[Count] = Joined;
+            SetPlug(Out + Count++, FindMatchingPlug(&Key, Column + 1), PLUG_OPEN);
+        }
+        else if(Left == PLUG_CLOSE && Up == PLUG_CLOSE)
+        {
+            Out[Count] = Joined;
+            SetPlug(Out + Count++, FindMatchingPlug(&Key, Column), PLUG_CLOSE);
+        }
+        else if(Left == PLUG_END && Up == PLUG_END)
+        {
+            // NOTE(Zyonji): both ends are connected, nothing else may be left open.
+            if(IsFrontierEmpty(&Joined))
+            {
+                Out[Count++] = Joined;
+            }
+        }
+        else if(Left == PLUG_END || Up == PLUG_END)
+        {
+            Out[Count] = Joined;
+            SetPlug(Out + Count++, FindMatchingPlug(&Key, (Left == PLUG_END) ? Column + 1 : Column), PLUG_END);
+        }
+        // NOTE(Zyonji): an open plug meeting its own close plug would be a loop.
+    }
+    return(Count);
+}
+
+internal u32
+GetFrontierTableCapacity(u32 MaxCount)
+{
+    // NOTE(Zyonji): tables are kept at most half full, which takes less than 4 slots for
+    // every state they can receive.
+    u32 Result = 0;
+    if(MaxCount)
+    {
+        Result = 2;
+        while(Result < 2 * MaxCount)
+        {
+            Result *= 2;
+        }
+    }
+    return(Result);
+}
+
+internal memory_index
+GetSolutionCounterMemorySize(u32 PartitionCount, u32 MaxStates)
+{
+    // NOTE(Zyonji): a step of at most MaxStates states makes at most 2 * MaxStates
+    // transitions, which is also the most states the next step can receive.
+    memory_index MaxTransitions = 2 * (memory_index)MaxStates;
+    memory_index ArenaSize = (4 * MaxTransitions * 2 * sizeof(u32) +
+                              MaxTransitions * (sizeof(frontier_key) + sizeof(solution_count)));
+    memory_index Result = (2 * (sizeof(frontier_tables) + ArenaSize) +
+                           PartitionCount * sizeof(frontier_transitions) +
+                           MaxTransitions * sizeof(frontier_transition));
+    return(Result);
+}
+
+internal void
+ReserveFrontierTable(frontier_tables *Set, u32 Partition, u32 *MaxCounts)
+{
+    // NOTE(Zyonji): every partition finds its place in the arena from the partitions
+    // before it, so they can be reserved in parallel.
+    u32 SlotOffset = 0;
+    u32 StateOffset = 0;
+    for(u32 Other = 0;
+        Other < Partition;
+        ++Other)
+    {
+        SlotOffset += GetFrontierTableCapacity(MaxCounts[Other]);
+        StateOffset += MaxCounts[Other];
+    }
+
+    frontier_table *Table = Set->Tables + Partition;
+    Table->Count = 0;
+    Table->Capacity = GetFrontierTableCapacity(MaxCounts[Partition]);
+    Table->Hashes = Set->Hashes + SlotOffset;
+    Table->Indices = Set->Indices + SlotOffset;
+    Table->Keys = Set->Keys + StateOffset;
+    Table->Counts = Set->Counts + StateOffset;
+    for(u32 I = 0;
+        I < Table->Capacity;
+        ++I)
+    {
+        Table->Hashes[I] = 0;
+    }
+}
+
+internal void
+InsertFrontier(solution_counter *Counter, frontier_table *Table, frontier_key *Key, u32 Hash, solution_count *Count)
+{
+    u32 Mask = Table->Capacity - 1;
+    u32 Slot = Hash & Mask;
+    while(Table->Hashes[Slot] &&
+          !(Table->Hashes[Slot] == Hash && AreFrontiersEqual(Table->Keys + Table->Indices[Slot], Key)))
+    {
+        Slot = (Slot + 1) & Mask;
+    }
+    if(Table->Hashes[Slot])
+    {
+        if(AddSolutionCount(Table->Counts + Table->Indices[Slot], Count))
+        {
+            Counter->Overflowed = true;
+        }
+    }
+    else
+    {
+        Table->Hashes[Slot] = Hash;
+        Table->Indices[Slot] = Table->Count;
+        Table->Keys[Table->Count] = *Key;
+        Table->Counts[Table->Count] = *Count;
+        ++Table->Count;
+    }
+}
+
+internal solution_count_status
+BeginSolutionCount(solution_counter *Counter, game_room *Room, u32 PartitionCount, u32 MaxStates, void *Memory)
+{
+    solution_count_status Result = SolutionCount_Counted;
+    *Counter = {};
+    Counter->Room = Room;
+    Counter->Transposed = (Room->Width > Room->Height - 2);
+    Counter->Rows = Counter->Transposed ? Room->Width : Room->Height - 2;
+    Counter->Columns = Counter->Transposed ? Room->Height - 2 : Room->Width;
+    Counter->PartitionCount = PartitionCount;
+    Counter->MaxStates = MaxStates;
+
+    u32 MaxTransitions = 2 * MaxStates;
+    u8 *At = (u8 *)Memory;
+    Counter->Source = (frontier_tables *)At;
+    Counter->Target = Counter->Source + 1;
+    Counter->Transitions = (frontier_transitions *)(Counter->Target + 1);
+    At = (u8 *)(Counter->Transitions + PartitionCount);
+    Counter->TransitionArena = (frontier_transition *)At;
+    At += MaxTransitions * sizeof(frontier_transition);
+    for(int SetIndex = 0;
+        SetIndex < 2;
+        ++SetIndex)
+    {
+        frontier_tables *Set = Counter->Source + SetIndex;
+        Set->Keys = (frontier_key *)At;
+        At += MaxTransitions * sizeof(frontier_key);
+        Set->Counts = (solution_count *)At;
+        At += MaxTransitions * sizeof(solution_count);
+        Set->Hashes = (u32 *)At;
+        At += 4 * MaxTransitions * sizeof(u32);
+        Set->Indices = (u32 *)At;
+        At += 4 * MaxTransitions * sizeof(u32);
+    }
+
+    if(Counter->Columns + 1 > 32 * FRONTIER_KEY_WORDS)
+    {
+        Result = SolutionCount_TooWide;
+    }
+    else
+    {
+        frontier_key Empty = {};
+        solution_count One = {};
+        One.Limbs[0] = 1;
+        u32 Hash = HashFrontier(&Empty);
+        u32 Partition = GetHashPartition(Counter, Hash);
+        u32 MaxCounts[MAX_SOLUTION_PARTITIONS] = {};
+        MaxCounts[Partition] = 1;
+        for(u32 Other = 0;
+            Other < PartitionCount;
+            ++Other)
+        {
+            ReserveFrontierTable(Counter->Source, Other, MaxCounts);
+        }
+        InsertFrontier(Counter, Counter->Source->Tables + Partition, &Empty, Hash, &One);
+    }
+    return(Result);
+}
+
+internal void
+ExpandSolutionPartition(solution_counter *Counter, u32 Partition)
+{
+    // NOTE(Zyonji): the transitions are generated twice, once to size the target ranges and
+    // once to store them grouped by target partition.
+    frontier_table *Source = Counter->Source->Tables + Partition;
+    frontier_transitions *Transitions = Counter->Transitions + Partition;
+    u32 TransitionOffset = 0;
+    for(u32 Other = 0;
+        Other < Partition;
+        ++Other)
+    {
+        TransitionOffset += 2 * Counter->Source->Tables[Other].Count;
+    }
+    Transitions->Transitions = Counter->TransitionArena + TransitionOffset;
+
+    u32 Offsets[MAX_SOLUTION_PARTITIONS + 1] = {};
+    for(int Pass = 0;
+        Pass < 2;
+        ++Pass)
+    {
+        for(u32 I = 0;
+            I < Source->Count;
+            ++I)
+        {
+            frontier_key Out[2];
+            int OutCount = GetCellTransitions(Counter, Source->Keys[I], Out);
+            for(int J = 0;
+                J < OutCount;
+                ++J)
+            {
+                u32 Hash = HashFrontier(Out + J);
+                u32 Target = GetHashPartition(Counter, Hash);
+                if(Pass == 0)
+                {
+                    ++Offsets[Target + 1];
+                }
+                else
+                {
+                    frontier_transition *Transition = Transitions->Transitions + Offsets[Target]++;
+                    Transition->Key = Out[J];
+                    Transition->Hash = Hash;
+                    Transition->Source = I;
+                }
+            }
+        }
+        if(Pass == 0)
+        {
+            for(u32 Target = 0;
+                Target < Counter->PartitionCount;
+                ++Target)
+            {
+                Offsets[Target + 1] += Offsets[Target];
+                Transitions->Offsets[Target] = Offsets[Target];
+            }
+            Transitions->Offsets[Counter->PartitionCount] = Offsets[Counter->PartitionCount];
+        }
+    }
+}
+
+internal void
+MergeSolutionPartition(solution_counter *Counter, u32 Partition)
+{
+    u32 MaxCounts[MAX_SOLUTION_PARTITIONS] = {};
+    for(u32 SourcePartition = 0;
+        SourcePartition < Counter->PartitionCount;
+        ++SourcePartition)
+    {
+        frontier_transitions *Transitions = Counter->Transitions + SourcePartition;
+        for(u32 Target = 0;
+            Target < Counter->PartitionCount;
+            ++Target)
+        {
+            MaxCounts[Target] += Transitions->Offsets[Target + 1] - Transitions->Offsets[Target];
+        }
+    }
+    ReserveFrontierTable(Counter->Target, Partition, MaxCounts);
+
+    frontier_table *Target = Counter->Target->Tables + Partition;
+    for(u32 SourcePartition = 0;
+        SourcePartition < Counter->PartitionCount;
+        ++SourcePartition)
+    {
+        frontier_table *Source = Counter->Source->Tables + SourcePartition;
+        frontier_transitions *Transitions = Counter->Transitions + SourcePartition;
+        for(u32 I = Transitions->Offsets[Partition];
+            I < Transitions->Offsets[Partition + 1];
+            ++I)
+        {
+            frontier_transition *Transition = Transitions->Transitions + I;
+            InsertFrontier(Counter, Target, &Transition->Key, Transition->Hash, Source->Counts + Transition->Source);
+        }
+    }
+}
+
+internal b32
+AdvanceSolutionCount(solution_counter *Counter)
+{
+    frontier_tables *Swap = Counter->Source;
+    Counter->Source = Counter->Target;
+    Counter->Target = Swap;
+
+    u32 StateCount = 0;
+    for(u32 Partition = 0;
+        Partition < Counter->PartitionCount;
+        ++Partition)
+    {
+        StateCount += Counter->Source->Tables[Partition].Count;
+    }
+    if(StateCount > Counter->MaxStates)
+    {
+        Counter->TooManyStates = true;
+    }
+
+    if(++Counter->Column == Counter->Columns)
+    {
+        Counter->Column = 0;
+        ++Counter->Row;
+    }
+    b32 Result = (Counter->Row < Counter->Rows && StateCount > 0 &&
+                  !Counter->TooManyStates && !Counter->Overflowed);
+    return(Result);
+}
+
+internal solution_count_status
+EndSolutionCount(solution_counter *Counter, solution_count *Count)
+{
+    solution_count_status Result = SolutionCount_Counted;
+    *Count = {};
+    if(Counter->TooManyStates)
+    {
+        Result = SolutionCount_TooManyStates;
+    }
+    else if(Counter->Overflowed)
+    {
+        Result = SolutionCount_Overflowed;
+    }
+    else if(Counter->Row == Counter->Rows)
+    {
+        // NOTE(Zyonji): after the last cell only finished paths have an empty frontier.
+        frontier_key Empty = {};
+        u32 Hash = HashFrontier(&Empty);
+        frontier_table *Table = Counter->Source->Tables + GetHashPartition(Counter, Hash);
+        for(u32 I = 0;
+            I < Table->Count;
+            ++I)
+        {
+            if(AreFrontiersEqual(Table->Keys + I, &Empty))
+            {
+                *Count = Table->Counts[I];
+            }
+        }
+    }
+    return(Result);
+}
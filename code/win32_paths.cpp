@@ -1,70 +1,6 @@
 #include <windows.h>
-#include <stdint.h>
-#include <stddef.h>
 
-#define internal static
-#define local_persist static
-#define global_variable static
-
-typedef int8_t i8;
-typedef int16_t i16;
-typedef int32_t i32;
-typedef int64_t i64;
-typedef i32 b32;
-
-typedef uint8_t u8;
-typedef uint16_t u16;
-typedef uint32_t u32;
-typedef uint64_t u64;
-
-typedef size_t memory_index;
-
-typedef float r32;
-typedef double r64;
-
-struct win32_offscreen_buffer
-{
-    BITMAPINFO Info;
-    void *Memory;
-    i32 Width;
-    i32 Height;
-    i32 Pitch;
-    i32 BytesPerPixel;
-    
-    i32 TileOffset;
-    u32 FreeColor;
-    u32 CheckedColor;
-    u32 BorderColor;
-};
-
-struct game_tile
-{
-    b32 IsFree;
-    i32 X;
-    i32 Y;
-    i32 PreviousX;
-    i32 PreviousY;
-    i32 NextX;
-    i32 NextY;
-};
-
-struct game_room
-{
-    i32 Width;
-    i32 Height;
-    game_tile *Tiles;
-};
-
-struct game_state
-{
-    b32 Running;
-    u32 Seed;
-    u32 RoomsCleared;
-    i32 X;
-    i32 Y;
-    game_room Room;
-    win32_offscreen_buffer Buffer;
-};
+#include "paths.h"
 
 struct game_save
 {
@@ -75,15 +11,7 @@ struct game_save
 
 global_variable game_state *GlobalGameState;
 
-internal u32
-AdvanceRandomNumber(u32 Number)
-{
-    u32 Result = Number;
-    u32 Subtraction = (Number & 7187) * 941083981;
-    u32 Addition = (Number & 141650963) * 433024223;
-    Result += 23 + Addition - Subtraction;
-    return(Result);
-}
+#include "paths.cpp"
 
 internal game_save
 LoadGame()
@@ -102,7 +30,7 @@ LoadGame()
     }
     if(AdvanceRandomNumber(Save.OldSeed + Save.RoomsCleared) != Save.Seed)
     {
-        Save = {0, 0, 420023};
+        Save = {0, 0, PATHS_FIRST_SEED};
     }
     return(Save);
 }
@@ -126,413 +54,23 @@ SaveGame(u32 OldSeed, u32 RoomsCleared, u32 Seed)
     return(Result);
 }
 
-internal game_tile*
-GetTile(game_state *GameState, int X, int Y)
-{
-    game_tile *Tile = (GameState->Room.Tiles + X + Y * GameState->Room.Width);
-    return(Tile);
-}
-
-internal b32
-IsTileFree(game_state *GameState, int X, int Y)
-{
-    b32 Result = false;
-    int Height = GameState->Room.Height;
-    int Width = GameState->Room.Width;
-    
-    if(X >= 0 && Y >= 0 && X < Width && Y < Height)
-    {
-        game_tile *Tile = GetTile(GameState, X, Y);
-        Result = Tile->IsFree;
-    }
-    return(Result);
-}
-
-internal void
-RedrawRoom(game_state *GameState)
-{
-    win32_offscreen_buffer *Buffer = &GameState->Buffer;
-    
-    u8 *PixelRow = (u8 *)Buffer->Memory;
-    int TileY = 0;
-    int SubY = 0;
-    for(int Y = 0;
-        Y < Buffer->Height;
-        ++Y)
-    {
-        u32 *Pixel = (u32 *)PixelRow;
-        int TileX = 0;
-        int SubX = 0;
-        for(int X = 0;
-            X < Buffer->Width;
-            ++X)
-        {
-            game_tile *Tile = GetTile(GameState, TileX, TileY);
-            if(SubX == 0 || SubY == 0)
-            {
-                *Pixel++ = Buffer->BorderColor;
-            }
-            else if(TileX == GameState->X && TileY == GameState->Y)
-            {
-                if((X & 1) == (Y & 1))
-                {
-                    *Pixel++ = 0x006F6F6F;
-                }
-                else
-                {
-                    *Pixel++ = 0x008F8F8F;
-                }
-            }
-            else if(Tile->IsFree)
-            {
-                *Pixel++ = Buffer->FreeColor;
-            }
-            else
-            {
-                *Pixel++ = Buffer->CheckedColor;
-            }
-            
-            if(++SubX == Buffer->TileOffset)
-            {
-                SubX = 0;
-                ++TileX;
-            }
-        }
-        if(++SubY == Buffer->TileOffset)
-        {
-            SubY = 0;
-            ++TileY;
-        }
-        PixelRow += Buffer->Pitch;
-    }
-}
-
-internal u32
-ComputeColor(r32 Value, u32 Continuum)
-{
-    u32 Result;
-    r32 Red;
-    r32 Green;
-    r32 Blue;
-    u32 Spectrum = Continuum % 600;
-    if(Spectrum < 100)
-    {
-        Red = 1.0f;
-        Green = Spectrum / 100.0f;
-        Blue = 0.0f;
-    }
-    else if(Spectrum < 200)
-    {
-        Red = (Spectrum - 100) / 100.0f;
-        Green = 1.0f;
-        Blue = 0.0f;
-    }
-    else if(Spectrum < 300)
-    {
-        Red = 0.0f;
-        Green = 1.0f;
-        Blue = (Spectrum - 200) / 100.0f;
-    }
-    else if(Spectrum < 400)
-    {
-        Red = 0.0f;
-        Green = (Spectrum - 300) / 100.0f;
-        Blue = 1.0f;
-    }
-    else if(Spectrum < 500)
-    {
-        Red = (Spectrum - 400) / 100.0f;
-        Green = 0.0f;
-        Blue = 1.0f;
-    }
-    else
-    {
-        Red = 1.0f;
-        Green = 0.0f;
-        Blue = (Spectrum - 500) / 100.0f;
-    }
-    Result = ((u32)(Red * Value) << 16) + ((u32)(Green * Value) << 8) + ((u32)(Blue * Value) << 0);
-    return(Result);
-}
-
-internal void
-ResetRoom(game_state *GameState)
-{
-    r32 Factor = 1.0f + GameState->RoomsCleared;
-    int Height = (int)(4.5f + 96.0f * Factor / (Factor + 200.0f));
-    int Width = (int)(1.5f * Height);
-    GameState->X = Width / 2;
-    GameState->Y = 0;
-    
-    game_room *Room = &GameState->Room;
-    Room->Height = Height;
-    Room->Width = Width;
-    Room->Tiles = (game_tile *)(GameState + 1);
-    
-    game_tile *TileRow = Room->Tiles;
-    for(int Y = 0;
-        Y < Height;
-        ++Y)
-    {
-        game_tile *Tile = TileRow;
-        for(int X = 0;
-            X < Width;
-            ++X)
-        {
-            Tile->X = X;
-            Tile->Y = Y;
-            if(X == GameState->X && Y != GameState->Y)
-            {
-                Tile->IsFree = true;
-                if(Y > 1)
-                {
-                    Tile->PreviousX = X;
-                    Tile->PreviousY = Y - 1;
-                }
-                else
-                {
-                    Tile->PreviousX = 0;
-                    Tile->PreviousY = 0;
-                }
-                if(Y < Height - 2)
-                {
-                    Tile->NextX = X;
-                    Tile->NextY = Y + 1;
-                }
-                else
-                {
-                    Tile->NextX = 0;
-                    Tile->NextY = 0;
-                }
-            }
-            else
-            {
-                Tile->IsFree = false;
-            }
-            ++Tile;
-        }
-        
-        TileRow += Width;
-    }
-    
-    u32 Random = AdvanceRandomNumber(GameState->Seed);
-    int RemainingTiles = (Height - 2) * (Width - 1);
-    int MinimumHoles = RemainingTiles / 8;
-    game_tile *FirstTile = Room->Tiles + Width - 1;
-    for(int I = 0;
-        I < 10 && RemainingTiles > MinimumHoles;
-        ++I)
-    {
-        int TileNumber = Random % RemainingTiles;
-        game_tile *Tile = FirstTile;
-        for(int J = 0;
-            J <= TileNumber;
-            J)
-        {
-            ++Tile;
-            if(!Tile->IsFree)
-            {
-                ++J;
-            }
-        }
-        Random = AdvanceRandomNumber(Random);
-        b32 MovedPath = false;
-        int Stretch = (Random & 0x7) + 2;
-        int Orientation = (Random & 0x30) / 0x10;
-        int X = Tile->X;
-        int Y = Tile->Y;
-        for(int J = 0;
-            J < 4 && !MovedPath;
-            ++J)
-        {
-            // NOTE(Zyonji): extending forward, pulling left
-            int dX = 0;
-            int dY = 0;
-            if(Orientation & 0x1)
-            {
-                if(Orientation & 0x2)
-                {
-                    dX = 1;
-                }
-                else
-                {
-                    dX = -1;
-                }
-            }
-            else
-            {
-                if(Orientation & 0x2)
-                {
-                    dY = 1;
-                }
-                else
-                {
-                    dY = -1;
-                }
-            }
-            
-            int TestX = X + dX;
-            int TestY = Y + dY;
-            game_tile *TestTile = GetTile(GameState, TestX, TestY);
-            while(TestX >= 0 && TestY > 0 && TestX < Width && TestY < Height - 1 && !TestTile->IsFree)
-            {
-                TestX += dX;
-                TestY += dY;
-                TestTile = GetTile(GameState, TestX, TestY);
-            }
-            if(TestX >= 0 && TestY > 0 && TestX < Width && TestY < Height - 1)
-            {
-                // NOTE(Zyonji): found path
-                int PathLength = 1;
-                while(((TestTile->NextX == TestX && dY == 0) || 
-                       (TestTile->NextY == TestY && dX == 0)) && PathLength <= Stretch)
-                {
-                    int PathX = TestTile->NextX - dX;
-                    int PathY = TestTile->NextY - dY;
-                    while(PathX != X && PathY != Y && !IsTileFree(GameState, PathX, PathY))
-                    {
-                        PathX -= dX;
-                        PathY -= dY;
-                    }
-                    if(IsTileFree(GameState, PathX, PathY))
-                    {
-                        break;
-                    }
-                    else
-                    {
-                        TestX = TestTile->NextX;
-                        TestY = TestTile->NextY;
-                        TestTile = GetTile(GameState, TestX, TestY);
-                    }
-                    ++PathLength;
-                }
-                
-                if(TestX != X && TestY != Y)
-                {
-                    int PathX = TestX;
-                    int PathY = TestY;
-                    game_tile *PathTile = GetTile(GameState, PathX, PathY);
-                    game_tile *OldTile = GetTile(GameState, PathTile->PreviousX, PathTile->PreviousY);
-                    PathX -= dX;
-                    PathY -= dY;
-                    PathTile->PreviousX = PathX;
-                    PathTile->PreviousY = PathY;
-                    PathTile = GetTile(GameState, PathX, PathY);
-                    while(PathX != X && PathY != Y)
-                    {
-                        PathTile->NextX = PathX + dX;
-                        PathTile->NextY = PathY + dY;
-                        PathX -= dX;
-                        PathY -= dY;
-                        PathTile->PreviousX = PathX;
-                        PathTile->PreviousY = PathY;
-                        PathTile->IsFree = true;
-                        --RemainingTiles;
-                        PathTile = GetTile(GameState, PathX, PathY);
-                    }
-                    int dX2 = 0;
-                    int dY2 = 0;
-                    if(PathX == X)
-                    {
-                        dY2 = OldTile->NextY - OldTile->Y;
-                    }
-                    if(PathY == Y)
-                    {
-                        dX2 = OldTile->NextX - OldTile->X;
-                    }
-                    PathTile->NextX = PathX + dX;
-                    PathTile->NextY = PathY + dY;
-                    PathX -= dX2;
-                    PathY -= dY2;
-                    PathTile->PreviousX = PathX;
-                    PathTile->PreviousY = PathY;
-                    PathTile->IsFree = true;
-                    --RemainingTiles;
-                    PathTile = GetTile(GameState, PathX, PathY);
-                    while(OldTile->X != X && OldTile->Y != Y)
-                    {
-                        PathTile->NextX = PathX + dX2;
-                        PathTile->NextY = PathY + dY2;
-                        PathX -= dX2;
-                        PathY -= dY2;
-                        PathTile->PreviousX = PathX;
-                        PathTile->PreviousY = PathY;
-                        PathTile->IsFree = true;
-                        PathTile = GetTile(GameState, PathX, PathY);
-                        OldTile->IsFree = false;
-                        OldTile = GetTile(GameState, OldTile->PreviousX, OldTile->PreviousY);
-                    }
-                    PathTile->NextX = PathX + dX2;
-                    PathTile->NextY = PathY + dY2;
-                    PathX += dX;
-                    PathY += dY;
-                    PathTile->PreviousX = PathX;
-                    PathTile->PreviousY = PathY;
-                    PathTile->IsFree = true;
-                    --RemainingTiles;
-                    PathTile = GetTile(GameState, PathX, PathY);
-                    while(PathX != TestX && PathY != TestY)
-                    {
-                        PathTile->NextX = PathX - dX;
-                        PathTile->NextY = PathY - dY;
-                        PathX += dX;
-                        PathY += dY;
-                        PathTile->PreviousX = PathX;
-                        PathTile->PreviousY = PathY;
-                        PathTile->IsFree = true;
-                        --RemainingTiles;
-                        PathTile = GetTile(GameState, PathX, PathY);
-                    }
-                    PathTile->NextX = PathX - dX;
-                    PathTile->NextY = PathY - dY;
-                    I = 0;
-                    break;
-                }
-            }
-            ++Orientation;
-        }
-        Random = AdvanceRandomNumber(Random);
-    }
-    
-    win32_offscreen_buffer *Buffer = &GameState->Buffer;
-    int BytesPerPixel = 4;
-    int TileWidth = 5;
-    int TileSpace = 1;
-    int TileOffset = TileWidth + TileSpace;
-    Buffer->Width = Width * TileOffset + TileSpace;
-    Buffer->Height = Height * TileOffset + TileSpace;
-    Buffer->BytesPerPixel = BytesPerPixel;
-    Buffer->Pitch = (Buffer->Width * BytesPerPixel + 15) & ~15;
-    Buffer->TileOffset = TileOffset;
-    Buffer->Memory = (void *)(Room->Tiles + Height * Width);
-    
-    Buffer->FreeColor = 0x00FFFFFF;
-    r32 Value = 256.0f * Factor / (Factor + 255.0f);
-    Buffer->CheckedColor = ComputeColor(Value, GameState->RoomsCleared);
-    Buffer->BorderColor = ComputeColor(Value, GameState->RoomsCleared + GameState->RoomsCleared / 10);
-    
-    Buffer->Info.bmiHeader.biSize = sizeof(Buffer->Info.bmiHeader);
-    Buffer->Info.bmiHeader.biWidth = Buffer->Pitch / BytesPerPixel;
-    Buffer->Info.bmiHeader.biHeight = Buffer->Height;
-    Buffer->Info.bmiHeader.biPlanes = 1;
-    Buffer->Info.bmiHeader.biBitCount = 32;
-    Buffer->Info.bmiHeader.biCompression = BI_RGB;
-    
-    RedrawRoom(GameState);
-}
-
 internal void
 PlayerMoveFor(game_state *GameState, int RelativeX, int RelativeY)
 {
     int X = GameState->X;
     int Y = GameState->Y;
     
-    if(IsTileFree(GameState, X + RelativeX, Y + RelativeY))
+    if(GameState->Doomed)
+    {
+        ResetRoom(GameState);
+    }
+    else if(IsTileFree(GameState, X + RelativeX, Y + RelativeY))
     {
         game_tile *Tile = GetTile(GameState, X, Y);
         Tile->IsFree = false;
         GameState->X += RelativeX;
         GameState->Y += RelativeY;
+        UpdateRoomChecks(GameState, X, Y);
         RedrawRoom(GameState);
     }
     else if(!IsTileFree(GameState, X + 1, Y) &&
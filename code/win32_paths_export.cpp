@@ -0,0 +1,1082 @@
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "paths.h"
+#include "paths.cpp"
+#include "paths_solutions.cpp"
+
+#define ArrayCount(Array) (sizeof(Array) / sizeof((Array)[0]))
+
+enum export_format
+{
+    ExportFormat_PPM,
+    ExportFormat_PNG,
+};
+
+struct export_settings
+{
+    u32 Seed;
+    u32 FirstRoom;
+    u32 RoomCount;
+    u32 AtlasColumns;
+    u32 ThreadCount;
+    b32 ShowSolution;
+    b32 VerifyBaked;
+    b32 CountSolutions;
+    u32 MaxSolutionWidth;
+    u32 MaxSolutionStates;
+    export_format Format;
+    char *OutputPrefix;
+};
+
+struct work_queue;
+#define WORK_QUEUE_CALLBACK(name) void name(work_queue *Queue, void *Data)
+typedef WORK_QUEUE_CALLBACK(work_queue_callback);
+
+struct work_queue_entry
+{
+    work_queue_callback *Callback;
+    void *Data;
+};
+
+struct work_queue
+{
+    u32 volatile CompletionGoal;
+    u32 volatile CompletionCount;
+    u32 volatile NextEntryToWrite;
+    u32 volatile NextEntryToRead;
+    HANDLE SemaphoreHandle;
+    work_queue_entry Entries[256];
+};
+
+struct bit_stream
+{
+    u8 *At;
+    u32 Buffer;
+    u32 Count;
+};
+
+struct export_row
+{
+    u8 *Raw;
+    u8 *Previous;
+    u8 *Encoded;
+    u32 RawSize;
+    u32 EncodedSize;
+    u32 Adler;
+};
+
+struct export_image
+{
+    HANDLE File;
+    export_format Format;
+    u32 Adler;
+    b32 Failed;
+};
+
+struct export_band
+{
+    export_format Format;
+    u32 Columns;
+    u32 CellCount;
+    i32 CellWidth;
+    i32 CellHeight;
+    game_state **Cells;
+};
+
+struct room_job
+{
+    export_settings *Settings;
+    game_state *GameState;
+    export_row Row;
+    b32 Succeeded;
+};
+
+struct row_job
+{
+    export_band *Band;
+    i32 PixelY;
+    export_row Row;
+};
+
+struct solution_job
+{
+    solution_counter *Counter;
+    u32 Partition;
+};
+
+global_variable u32 Crc32Table[256];
+
+internal void
+AddEntry(work_queue *Queue, work_queue_callback *Callback, void *Data)
+{
+    u32 NewNextEntryToWrite = (Queue->NextEntryToWrite + 1) % (u32)ArrayCount(Queue->Entries);
+    work_queue_entry *Entry = Queue->Entries + Queue->NextEntryToWrite;
+    Entry->Callback = Callback;
+    Entry->Data = Data;
+    ++Queue->CompletionGoal;
+    MemoryBarrier();
+    Queue->NextEntryToWrite = NewNextEntryToWrite;
+    ReleaseSemaphore(Queue->SemaphoreHandle, 1, 0);
+}
+
+internal b32
+DoNextWorkQueueEntry(work_queue *Queue)
+{
+    b32 WeShouldSleep = false;
+    u32 OriginalNextEntryToRead = Queue->NextEntryToRead;
+    u32 NewNextEntryToRead = (OriginalNextEntryToRead + 1) % (u32)ArrayCount(Queue->Entries);
+    if(OriginalNextEntryToRead != Queue->NextEntryToWrite)
+    {
+        work_queue_entry Entry = Queue->Entries[OriginalNextEntryToRead];
+        u32 Index = InterlockedCompareExchange((LONG volatile *)&Queue->NextEntryToRead,
+                                               NewNextEntryToRead, OriginalNextEntryToRead);
+        if(Index == OriginalNextEntryToRead)
+        {
+            Entry.Callback(Queue, Entry.Data);
+            InterlockedIncrement((LONG volatile *)&Queue->CompletionCount);
+        }
+    }
+    else
+    {
+        WeShouldSleep = true;
+    }
+    return(WeShouldSleep);
+}
+
+internal void
+CompleteAllWork(work_queue *Queue)
+{
+    while(Queue->CompletionGoal != Queue->CompletionCount)
+    {
+        DoNextWorkQueueEntry(Queue);
+    }
+    Queue->CompletionGoal = 0;
+    Queue->CompletionCount = 0;
+}
+
+DWORD WINAPI
+ThreadProc(LPVOID Parameter)
+{
+    work_queue *Queue = (work_queue *)Parameter;
+    for(;;)
+    {
+        if(DoNextWorkQueueEntry(Queue))
+        {
+            WaitForSingleObjectEx(Queue->SemaphoreHandle, INFINITE, FALSE);
+        }
+    }
+}
+
+internal void
+InitializeCrc32Table()
+{
+    for(u32 I = 0;
+        I < 256;
+        ++I)
+    {
+        u32 Crc = I;
+        for(int J = 0;
+            J < 8;
+            ++J)
+        {
+            Crc = (Crc & 1) ? (0xEDB88320 ^ (Crc >> 1)) : (Crc >> 1);
+        }
+        Crc32Table[I] = Crc;
+    }
+}
+
+internal u32
+ComputeCrc32(u8 *Data, u32 Size)
+{
+    u32 Crc = 0xFFFFFFFF;
+    for(u32 I = 0;
+        I < Size;
+        ++I)
+    {
+        Crc = Crc32Table[(Crc ^ Data[I]) & 0xFF] ^ (Crc >> 8);
+    }
+    return(Crc ^ 0xFFFFFFFF);
+}
+
+internal u32
+ComputeAdler32(u8 *Data, u32 Size)
+{
+    u32 A = 1;
+    u32 B = 0;
+    for(u32 I = 0;
+        I < Size;
+        ++I)
+    {
+        A = (A + Data[I]) % 65521;
+        B = (B + A) % 65521;
+    }
+    return((B << 16) | A);
+}
+
+internal u32
+CombineAdler32(u32 Adler, u32 NextAdler, u32 NextSize)
+{
+    // NOTE(Zyonji): appending data shifts its second sum by its length times the first sum.
+    u64 A = Adler & 0xFFFF;
+    u64 B = Adler >> 16;
+    u64 NextA = NextAdler & 0xFFFF;
+    u64 NextB = NextAdler >> 16;
+    u64 ResultA = (A + NextA + 65520) % 65521;
+    u64 ResultB = (B + NextB + (NextSize % 65521) * (A + 65520)) % 65521;
+    return((u32)((ResultB << 16) | ResultA));
+}
+
+internal u8 *
+PutBigEndian(u8 *At, u32 Value)
+{
+    *At++ = (u8)(Value >> 24);
+    *At++ = (u8)(Value >> 16);
+    *At++ = (u8)(Value >> 8);
+    *At++ = (u8)(Value >> 0);
+    return(At);
+}
+
+internal void
+PutBits(bit_stream *Stream, u32 Value, u32 Count)
+{
+    Stream->Buffer |= Value << Stream->Count;
+    Stream->Count += Count;
+    while(Stream->Count >= 8)
+    {
+        *Stream->At++ = (u8)Stream->Buffer;
+        Stream->Buffer >>= 8;
+        Stream->Count -= 8;
+    }
+}
+
+internal void
+PutHuffmanCode(bit_stream *Stream, u32 Code, u32 Length)
+{
+    u32 Reversed = 0;
+    for(u32 I = 0;
+        I < Length;
+        ++I)
+    {
+        Reversed = (Reversed << 1) | (Code & 1);
+        Code >>= 1;
+    }
+    PutBits(Stream, Reversed, Length);
+}
+
+internal void
+PutFixedSymbol(bit_stream *Stream, u32 Symbol)
+{
+    if(Symbol < 144)
+    {
+        PutHuffmanCode(Stream, 0x30 + Symbol, 8);
+    }
+    else if(Symbol < 256)
+    {
+        PutHuffmanCode(Stream, 0x190 + Symbol - 144, 9);
+    }
+    else if(Symbol < 280)
+    {
+        PutHuffmanCode(Stream, Symbol - 256, 7);
+    }
+    else
+    {
+        PutHuffmanCode(Stream, 0xC0 + Symbol - 280, 8);
+    }
+}
+
+internal void
+PutFixedMatch(bit_stream *Stream, u32 Length, u32 DistanceCode)
+{
+    local_persist u32 LengthBase[] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    local_persist u32 LengthExtra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    u32 Code = (u32)ArrayCount(LengthBase) - 1;
+    while(LengthBase[Code] > Length)
+    {
+        --Code;
+    }
+    PutFixedSymbol(Stream, 257 + Code);
+    PutBits(Stream, Length - LengthBase[Code], LengthExtra[Code]);
+    PutHuffmanCode(Stream, DistanceCode, 5);
+}
+
+internal u8 *
+DeflateRow(u8 *Data, u32 Size, u8 *Out)
+{
+    // NOTE(Zyonji): Every row is its own fixed huffman block and only matches against the
+    // previous pixel, so rows can be compressed on any thread and concatenated in order.
+    // The empty stored block at the end byte-aligns the stream for the next row.
+    bit_stream Stream = {Out, 0, 0};
+    PutBits(&Stream, 0, 1);
+    PutBits(&Stream, 1, 2);
+    u32 Distance = 3;
+    u32 DistanceCode = 2;
+    u32 I = 0;
+    while(I < Size)
+    {
+        u32 Length = 0;
+        if(I >= Distance)
+        {
+            while(I + Length < Size && Length < 258 && Data[I + Length] == Data[I + Length - Distance])
+            {
+                ++Length;
+            }
+        }
+        if(Length >= 3)
+        {
+            PutFixedMatch(&Stream, Length, DistanceCode);
+            I += Length;
+        }
+        else
+        {
+            PutFixedSymbol(&Stream, Data[I]);
+            ++I;
+        }
+    }
+    PutFixedSymbol(&Stream, 256);
+    PutBits(&Stream, 0, 3);
+    PutBits(&Stream, 0, (8 - Stream.Count) & 7);
+    *Stream.At++ = 0x00;
+    *Stream.At++ = 0x00;
+    *Stream.At++ = 0xFF;
+    *Stream.At++ = 0xFF;
+    return(Stream.At);
+}
+
+internal u8 *
+PutChunk(u8 *At, char *Type, u8 *Data, u32 Size)
+{
+    // NOTE(Zyonji): Data may already be in place right after the chunk header.
+    u8 *Chunk = At;
+    At = PutBigEndian(At, Size);
+    memcpy(At, Type, 4);
+    if(Data != At + 4)
+    {
+        memmove(At + 4, Data, Size);
+    }
+    At += 4 + Size;
+    At = PutBigEndian(At, ComputeCrc32(Chunk + 4, Size + 4));
+    return(At);
+}
+
+internal void
+FillRoomRow(game_state *GameState, i32 PixelY, u8 *Out, i32 Width)
+{
+    win32_offscreen_buffer *Buffer = &GameState->Buffer;
+    i32 X = 0;
+    if(PixelY < Buffer->Height)
+    {
+        // NOTE(Zyonji): the buffer is stored bottom up, images are written top down.
+        u32 *Pixel = (u32 *)((u8 *)Buffer->Memory + (Buffer->Height - 1 - PixelY) * Buffer->Pitch);
+        for(;
+            X < Buffer->Width && X < Width;
+            ++X)
+        {
+            u32 Color = *Pixel++;
+            *Out++ = (u8)(Color >> 16);
+            *Out++ = (u8)(Color >> 8);
+            *Out++ = (u8)(Color >> 0);
+        }
+    }
+    memset(Out, 0, 3 * (Width - X));
+}
+
+internal void
+FillBandRow(export_band *Band, i32 PixelY, u8 *Out)
+{
+    for(u32 Column = 0;
+        Column < Band->Columns;
+        ++Column)
+    {
+        u8 *CellOut = Out + 3 * Column * Band->CellWidth;
+        if(Column < Band->CellCount)
+        {
+            FillRoomRow(Band->Cells[Column], PixelY, CellOut, Band->CellWidth);
+        }
+        else
+        {
+            memset(CellOut, 0, 3 * Band->CellWidth);
+        }
+    }
+}
+
+internal void
+EncodeBandRow(export_band *Band, i32 PixelY, export_row *Row)
+{
+    u8 *Raw = Row->Raw;
+    FillBandRow(Band, PixelY, Raw + 1);
+    if(Band->Format == ExportFormat_PNG)
+    {
+        // NOTE(Zyonji): Rooms are drawn in stripes of identical rows, the up filter turns
+        // those into zeros. The first row of a band has nothing to refer to.
+        Raw[0] = 0;
+        if(PixelY > 0)
+        {
+            Raw[0] = 2;
+            FillBandRow(Band, PixelY - 1, Row->Previous + 1);
+            for(u32 I = Row->RawSize - 1;
+                I > 0;
+                --I)
+            {
+                Raw[I] = (u8)(Raw[I] - Row->Previous[I]);
+            }
+        }
+        Row->Adler = ComputeAdler32(Raw, Row->RawSize);
+
+        u8 *Data = Row->Encoded + 8;
+        u32 DataSize = (u32)(DeflateRow(Raw, Row->RawSize, Data) - Data);
+        Row->EncodedSize = (u32)(PutChunk(Row->Encoded, "IDAT", Data, DataSize) - Row->Encoded);
+    }
+}
+
+internal void
+WriteBytes(export_image *Image, void *Data, u32 Size)
+{
+    DWORD BytesWritten;
+    if(!Image->Failed &&
+       !(WriteFile(Image->File, Data, Size, &BytesWritten, 0) && BytesWritten == Size))
+    {
+        Image->Failed = true;
+    }
+}
+
+internal b32
+BeginImage(export_image *Image, char *FileName, export_format Format, u32 Width, u32 Height)
+{
+    Image->Format = Format;
+    Image->Adler = 1;
+    Image->Failed = false;
+    Image->File = CreateFileA(FileName, GENERIC_WRITE, 0, 0, CREATE_ALWAYS, 0, 0);
+    if(Image->File != INVALID_HANDLE_VALUE)
+    {
+        u8 Header[64];
+        u8 *At = Header;
+        if(Format == ExportFormat_PPM)
+        {
+            At += sprintf_s((char *)Header, sizeof(Header), "P6\n%u %u\n255\n", Width, Height);
+        }
+        else
+        {
+            u8 Signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+            memcpy(At, Signature, sizeof(Signature));
+            At += sizeof(Signature);
+
+            u8 ImageHeader[13];
+            u8 *HeaderAt = PutBigEndian(PutBigEndian(ImageHeader, Width), Height);
+            *HeaderAt++ = 8;
+            *HeaderAt++ = 2;
+            *HeaderAt++ = 0;
+            *HeaderAt++ = 0;
+            *HeaderAt++ = 0;
+            At = PutChunk(At, "IHDR", ImageHeader, sizeof(ImageHeader));
+
+            u8 ZlibHeader[] = {0x78, 0x01};
+            At = PutChunk(At, "IDAT", ZlibHeader, sizeof(ZlibHeader));
+        }
+        WriteBytes(Image, Header, (u32)(At - Header));
+    }
+    else
+    {
+        Image->Failed = true;
+    }
+    return(!Image->Failed);
+}
+
+internal void
+WriteImageRow(export_image *Image, export_row *Row)
+{
+    if(Image->Format == ExportFormat_PNG)
+    {
+        Image->Adler = CombineAdler32(Image->Adler, Row->Adler, Row->RawSize);
+        WriteBytes(Image, Row->Encoded, Row->EncodedSize);
+    }
+    else
+    {
+        WriteBytes(Image, Row->Raw + 1, Row->RawSize - 1);
+    }
+}
+
+internal b32
+EndImage(export_image *Image)
+{
+    if(Image->File != INVALID_HANDLE_VALUE)
+    {
+        if(Image->Format == ExportFormat_PNG)
+        {
+            u8 Trailer[64];
+            u8 FinalBlock[9] = {0x01, 0x00, 0x00, 0xFF, 0xFF};
+            PutBigEndian(FinalBlock + 5, Image->Adler);
+            u8 *At = PutChunk(Trailer, "IDAT", FinalBlock, sizeof(FinalBlock));
+            At = PutChunk(At, "IEND", 0, 0);
+            WriteBytes(Image, Trailer, (u32)(At - Trailer));
+        }
+        CloseHandle(Image->File);
+    }
+    return(!Image->Failed);
+}
+
+internal u32
+GetRowSize(u32 Width)
+{
+    u32 Result = 1 + 3 * Width;
+    return(Result);
+}
+
+internal u32
+GetEncodedRowSize(u32 Width)
+{
+    // NOTE(Zyonji): a literal costs at most 9 bits, plus block, flush and chunk overhead.
+    u32 Result = 2 * GetRowSize(Width) + 64;
+    return(Result);
+}
+
+internal u8 *
+AllocateRow(export_row *Row, u32 Width, u8 *Memory)
+{
+    Row->RawSize = GetRowSize(Width);
+    Row->Raw = Memory;
+    Row->Previous = Row->Raw + Row->RawSize;
+    Row->Encoded = Row->Previous + Row->RawSize;
+    return(Row->Encoded + GetEncodedRowSize(Width));
+}
+
+internal memory_index
+GetGameStateSize(room_size MaxSize)
+{
+    memory_index Pitch = (MaxSize.PixelWidth * 4 + 15) & ~15;
+    memory_index Result = sizeof(game_state) +
+        MaxSize.Width * MaxSize.Height * sizeof(game_tile) +
+        MaxSize.PixelHeight * Pitch;
+    Result = (Result + 15) & ~15;
+    return(Result);
+}
+
+internal int
+VerifyBakedRooms(game_tile *Tiles)
+{
+    // NOTE(Zyonji): Tiles has to hold two rooms of BakedMaxSize. The generated room starts
+    // from garbage so a dependency on stale tiles shows up as well.
+    int Result = 0;
+    int MaxTiles = BakedMaxSize.Width * BakedMaxSize.Height;
+    u32 Seed = PATHS_FIRST_SEED;
+    for(u32 RoomsCleared = 0;
+        RoomsCleared < PATHS_BAKED_ROOMS;
+        ++RoomsCleared)
+    {
+        if(RoomsCleared)
+        {
+            Seed = AdvanceRandomNumber(Seed + RoomsCleared);
+        }
+        room_size Size = GetRoomSize(RoomsCleared);
+        game_room Generated = {Size.Width, Size.Height, Tiles};
+        game_room Baked = {Size.Width, Size.Height, Tiles + MaxTiles};
+        memset(Tiles, 0xCD, MaxTiles * sizeof(game_tile));
+        GenerateRoom(&Generated, Seed);
+
+        b32 Matches = UnpackBakedRoom(&Baked, Seed, RoomsCleared);
+        for(int I = 0;
+            Matches && I < Size.Width * Size.Height;
+            ++I)
+        {
+            game_tile *A = Generated.Tiles + I;
+            game_tile *B = Baked.Tiles + I;
+            if(A->IsFree != B->IsFree ||
+               (A->IsFree && (A->NextX != B->NextX || A->NextY != B->NextY ||
+                              A->PreviousX != B->PreviousX || A->PreviousY != B->PreviousY)))
+            {
+                Matches = false;
+            }
+        }
+        if(!Matches)
+        {
+            ++Result;
+        }
+    }
+    return(Result);
+}
+
+internal WORK_QUEUE_CALLBACK(GenerateRoomWork)
+{
+    game_state *GameState = (game_state *)Data;
+    ResetRoom(GameState);
+}
+
+internal WORK_QUEUE_CALLBACK(EncodeRowWork)
+{
+    row_job *Job = (row_job *)Data;
+    EncodeBandRow(Job->Band, Job->PixelY, &Job->Row);
+}
+
+internal WORK_QUEUE_CALLBACK(ExportRoomWork)
+{
+    room_job *Job = (room_job *)Data;
+    export_settings *Settings = Job->Settings;
+    game_state *GameState = Job->GameState;
+    ResetRoom(GameState);
+
+    export_band Band = {};
+    Band.Format = Settings->Format;
+    Band.Columns = 1;
+    Band.CellCount = 1;
+    Band.CellWidth = GameState->Buffer.Width;
+    Band.CellHeight = GameState->Buffer.Height;
+    Band.Cells = &GameState;
+
+    char FileName[MAX_PATH];
+    sprintf_s(FileName, sizeof(FileName), "%s_%u.%s", Settings->OutputPrefix, GameState->RoomsCleared,
+              (Settings->Format == ExportFormat_PNG) ? "png" : "ppm");
+    export_image Image;
+    if(BeginImage(&Image, FileName, Settings->Format, Band.CellWidth, Band.CellHeight))
+    {
+        Job->Row.RawSize = GetRowSize(Band.CellWidth);
+        for(i32 PixelY = 0;
+            PixelY < Band.CellHeight;
+            ++PixelY)
+        {
+            EncodeBandRow(&Band, PixelY, &Job->Row);
+            WriteImageRow(&Image, &Job->Row);
+        }
+    }
+    Job->Succeeded = EndImage(&Image);
+    if(!Job->Succeeded)
+    {
+        fprintf(stderr, "Could not write %s.\n", FileName);
+    }
+}
+
+internal b32
+ExportRooms(work_queue *Queue, export_settings *Settings, room_size MaxSize)
+{
+    b32 Result = true;
+    room_job Jobs[64];
+    u32 JobCount = Settings->ThreadCount;
+    memory_index StateSize = GetGameStateSize(MaxSize);
+    memory_index JobSize = (StateSize + 4 * GetEncodedRowSize(MaxSize.PixelWidth) + 15) & ~15;
+    u8 *Memory = (u8 *)VirtualAlloc(0, JobCount * JobSize, MEM_RESERVE|MEM_COMMIT, PAGE_READWRITE);
+    if(!Memory)
+    {
+        fprintf(stderr, "Could not allocate memory.\n");
+        return(false);
+    }
+    for(u32 I = 0;
+        I < JobCount;
+        ++I)
+    {
+        room_job *Job = Jobs + I;
+        Job->Settings = Settings;
+        Job->GameState = (game_state *)(Memory + I * JobSize);
+        Job->GameState->ShowSolution = Settings->ShowSolution;
+        AllocateRow(&Job->Row, MaxSize.PixelWidth, (u8 *)Job->GameState + StateSize);
+    }
+
+    u32 Seed = Settings->Seed;
+    u32 RoomsCleared = Settings->FirstRoom;
+    u32 LastRoom = Settings->FirstRoom + Settings->RoomCount;
+    while(RoomsCleared < LastRoom)
+    {
+        u32 BatchCount = 0;
+        for(;
+            BatchCount < JobCount && RoomsCleared < LastRoom;
+            ++BatchCount)
+        {
+            room_job *Job = Jobs + BatchCount;
+            Job->GameState->Seed = Seed;
+            Job->GameState->RoomsCleared = RoomsCleared;
+            AddEntry(Queue, ExportRoomWork, Job);
+            ++RoomsCleared;
+            Seed = AdvanceRandomNumber(Seed + RoomsCleared);
+        }
+        CompleteAllWork(Queue);
+        for(u32 I = 0;
+            I < BatchCount;
+            ++I)
+        {
+            Result &= Jobs[I].Succeeded;
+        }
+    }
+
+    VirtualFree(Memory, 0, MEM_RELEASE);
+    return(Result);
+}
+
+internal b32
+ExportAtlas(work_queue *Queue, export_settings *Settings, room_size MaxSize)
+{
+    export_band Band = {};
+    Band.Format = Settings->Format;
+    Band.Columns = Settings->AtlasColumns;
+    Band.CellWidth = MaxSize.PixelWidth;
+    Band.CellHeight = MaxSize.PixelHeight;
+    u32 Bands = (Settings->RoomCount + Band.Columns - 1) / Band.Columns;
+    u32 Width = Band.Columns * Band.CellWidth;
+    u32 Height = Bands * Band.CellHeight;
+
+    // NOTE(Zyonji): Only one band of rooms and one batch of rows is kept in memory.
+    row_job Jobs[128];
+    u32 JobCount = 2 * Settings->ThreadCount;
+    memory_index StateSize = GetGameStateSize(MaxSize);
+    memory_index RowSize = 2 * GetRowSize(Width) + GetEncodedRowSize(Width);
+    memory_index MemorySize = Band.Columns * (StateSize + sizeof(game_state *)) + JobCount * RowSize;
+    u8 *Memory = (u8 *)VirtualAlloc(0, MemorySize, MEM_RESERVE|MEM_COMMIT, PAGE_READWRITE);
+    if(!Memory)
+    {
+        fprintf(stderr, "Could not allocate memory.\n");
+        return(false);
+    }
+    Band.Cells = (game_state **)(Memory + Band.Columns * StateSize);
+    for(u32 Column = 0;
+        Column < Band.Columns;
+        ++Column)
+    {
+        Band.Cells[Column] = (game_state *)(Memory + Column * StateSize);
+        Band.Cells[Column]->ShowSolution = Settings->ShowSolution;
+    }
+    u8 *At = (u8 *)(Band.Cells + Band.Columns);
+    for(u32 I = 0;
+        I < JobCount;
+        ++I)
+    {
+        Jobs[I].Band = &Band;
+        At = AllocateRow(&Jobs[I].Row, Width, At);
+    }
+
+    char FileName[MAX_PATH];
+    sprintf_s(FileName, sizeof(FileName), "%s_atlas_%u_%u.%s", Settings->OutputPrefix,
+              Settings->FirstRoom, Settings->FirstRoom + Settings->RoomCount - 1,
+              (Settings->Format == ExportFormat_PNG) ? "png" : "ppm");
+    export_image Image;
+    if(BeginImage(&Image, FileName, Settings->Format, Width, Height))
+    {
+        u32 Seed = Settings->Seed;
+        u32 RoomsCleared = Settings->FirstRoom;
+        u32 LastRoom = Settings->FirstRoom + Settings->RoomCount;
+        for(u32 BandIndex = 0;
+            BandIndex < Bands && !Image.Failed;
+            ++BandIndex)
+        {
+            for(Band.CellCount = 0;
+                Band.CellCount < Band.Columns && RoomsCleared < LastRoom;
+                ++Band.CellCount)
+            {
+                game_state *GameState = Band.Cells[Band.CellCount];
+                GameState->Seed = Seed;
+                GameState->RoomsCleared = RoomsCleared;
+                AddEntry(Queue, GenerateRoomWork, GameState);
+                ++RoomsCleared;
+                Seed = AdvanceRandomNumber(Seed + RoomsCleared);
+            }
+            CompleteAllWork(Queue);
+
+            for(i32 PixelY = 0;
+                PixelY < Band.CellHeight;
+                PixelY += JobCount)
+            {
+                u32 BatchCount = 0;
+                for(;
+                    BatchCount < JobCount && PixelY + (i32)BatchCount < Band.CellHeight;
+                    ++BatchCount)
+                {
+                    Jobs[BatchCount].PixelY = PixelY + BatchCount;
+                    AddEntry(Queue, EncodeRowWork, Jobs + BatchCount);
+                }
+                CompleteAllWork(Queue);
+                for(u32 I = 0;
+                    I < BatchCount;
+                    ++I)
+                {
+                    WriteImageRow(&Image, &Jobs[I].Row);
+                }
+            }
+        }
+    }
+    b32 Result = EndImage(&Image);
+    if(!Result)
+    {
+        fprintf(stderr, "Could not write %s.\n", FileName);
+    }
+
+    VirtualFree(Memory, 0, MEM_RELEASE);
+    return(Result);
+}
+
+internal WORK_QUEUE_CALLBACK(ExpandSolutionWork)
+{
+    solution_job *Job = (solution_job *)Data;
+    ExpandSolutionPartition(Job->Counter, Job->Partition);
+}
+
+internal WORK_QUEUE_CALLBACK(MergeSolutionWork)
+{
+    solution_job *Job = (solution_job *)Data;
+    MergeSolutionPartition(Job->Counter, Job->Partition);
+}
+
+internal b32
+CountRoomSolutions(work_queue *Queue, export_settings *Settings, room_size MaxSize)
+{
+    solution_counter Counter;
+    solution_job Jobs[MAX_SOLUTION_PARTITIONS];
+    u32 PartitionCount = Settings->ThreadCount;
+    memory_index StateSize = GetGameStateSize(MaxSize);
+    memory_index MemorySize = StateSize + GetSolutionCounterMemorySize(PartitionCount, Settings->MaxSolutionStates);
+    u8 *Memory = (u8 *)VirtualAlloc(0, MemorySize, MEM_RESERVE|MEM_COMMIT, PAGE_READWRITE);
+    if(!Memory)
+    {
+        fprintf(stderr, "Could not allocate memory.\n");
+        return(false);
+    }
+    for(u32 Partition = 0;
+        Partition < PartitionCount;
+        ++Partition)
+    {
+        Jobs[Partition].Counter = &Counter;
+        Jobs[Partition].Partition = Partition;
+    }
+
+    game_state *GameState = (game_state *)Memory;
+    GameState->Seed = Settings->Seed;
+    GameState->RoomsCleared = Settings->FirstRoom;
+    for(u32 RoomIndex = 0;
+        RoomIndex < Settings->RoomCount;
+        ++RoomIndex)
+    {
+        if(RoomIndex)
+        {
+            ++GameState->RoomsCleared;
+            GameState->Seed = AdvanceRandomNumber(GameState->Seed + GameState->RoomsCleared);
+        }
+        ResetRoom(GameState);
+        game_room *Room = &GameState->Room;
+        printf("room %u seed %u %dx%d ", GameState->RoomsCleared, GameState->Seed, Room->Width, Room->Height);
+
+        solution_count_status Status = SolutionCount_TooWide;
+        solution_count Count = {};
+        if((u32)Room->Width <= Settings->MaxSolutionWidth)
+        {
+            Status = BeginSolutionCount(&Counter, Room, PartitionCount, Settings->MaxSolutionStates, Memory + StateSize);
+        }
+        if(Status == SolutionCount_Counted)
+        {
+            do
+            {
+                for(u32 Partition = 0;
+                    Partition < PartitionCount;
+                    ++Partition)
+                {
+                    AddEntry(Queue, ExpandSolutionWork, Jobs + Partition);
+                }
+                CompleteAllWork(Queue);
+                for(u32 Partition = 0;
+                    Partition < PartitionCount;
+                    ++Partition)
+                {
+                    AddEntry(Queue, MergeSolutionWork, Jobs + Partition);
+                }
+                CompleteAllWork(Queue);
+            } while(AdvanceSolutionCount(&Counter));
+            Status = EndSolutionCount(&Counter, &Count);
+        }
+
+        switch(Status)
+        {
+            case SolutionCount_Counted:
+            {
+                char Buffer[20 * SOLUTION_COUNT_LIMBS + 1];
+                printf("solutions %s\n", FormatSolutionCount(Count, Buffer));
+            } break;
+
+            case SolutionCount_Overflowed:
+            {
+                printf("solutions overflowed\n");
+            } break;
+
+            case SolutionCount_TooManyStates:
+            {
+                printf("solutions too many states\n");
+            } break;
+
+            case SolutionCount_TooWide:
+            {
+                printf("solutions too wide\n");
+            } break;
+        }
+    }
+
+    VirtualFree(Memory, 0, MEM_RELEASE);
+    return(true);
+}
+
+internal void
+PrintUsage()
+{
+    fprintf(stderr,
+            "usage: win32_paths_export [options]\n"
+            "  -count N      number of rooms to export (default 1)\n"
+            "  -first N      rooms cleared before the first exported room (default 0)\n"
+            "  -seed N       seed of the first exported room (default: follow the default chain)\n"
+            "  -solution     draw the generated solution path\n"
+            "  -png          write png instead of ppm\n"
+            "  -atlas N      write a single contact sheet with N rooms per row\n"
+            "  -threads N    number of threads (default: one per processor)\n"
+            "  -out PREFIX   output file prefix (default room)\n"
+            "  -verifybaked  only check the compile time rooms against the generator\n"
+            "  -solutions    print the number of solutions of every room instead of images\n"
+            "  -maxwidth N   skip counting rooms wider than N (default 24, the widest the default\n"
+            "                -maxstates counts; from about 28 they overflow the default 128 bit count)\n"
+            "  -maxstates N  give up counting a room when one step has more than N frontier states,\n"
+            "                the same on any number of threads (default 262144, at most 268435456)\n");
+}
+
+int
+main(int ArgCount, char **Args)
+{
+    SYSTEM_INFO SystemInfo;
+    GetSystemInfo(&SystemInfo);
+
+    export_settings Settings = {};
+    Settings.RoomCount = 1;
+    Settings.ThreadCount = SystemInfo.dwNumberOfProcessors;
+    Settings.Format = ExportFormat_PPM;
+    Settings.OutputPrefix = "room";
+    Settings.MaxSolutionWidth = 24;
+    Settings.MaxSolutionStates = 1 << 18;
+    b32 HasSeed = false;
+    for(int I = 1;
+        I < ArgCount;
+        ++I)
+    {
+        char *Arg = Args[I];
+        char *Value = (I + 1 < ArgCount) ? Args[I + 1] : 0;
+        if(strcmp(Arg, "-solution") == 0)
+        {
+            Settings.ShowSolution = true;
+        }
+        else if(strcmp(Arg, "-verifybaked") == 0)
+        {
+            Settings.VerifyBaked = true;
+        }
+        else if(strcmp(Arg, "-solutions") == 0)
+        {
+            Settings.CountSolutions = true;
+        }
+        else if(Value && strcmp(Arg, "-maxwidth") == 0)
+        {
+            Settings.MaxSolutionWidth = strtoul(Value, 0, 0);
+            ++I;
+        }
+        else if(Value && strcmp(Arg, "-maxstates") == 0)
+        {
+            Settings.MaxSolutionStates = strtoul(Value, 0, 0);
+            ++I;
+        }
+        else if(strcmp(Arg, "-png") == 0)
+        {
+            Settings.Format = ExportFormat_PNG;
+        }
+        else if(Value && strcmp(Arg, "-count") == 0)
+        {
+            Settings.RoomCount = strtoul(Value, 0, 0);
+            ++I;
+        }
+        else if(Value && strcmp(Arg, "-first") == 0)
+        {
+            Settings.FirstRoom = strtoul(Value, 0, 0);
+            ++I;
+        }
+        else if(Value && strcmp(Arg, "-seed") == 0)
+        {
+            Settings.Seed = strtoul(Value, 0, 0);
+            HasSeed = true;
+            ++I;
+        }
+        else if(Value && strcmp(Arg, "-atlas") == 0)
+        {
+            Settings.AtlasColumns = strtoul(Value, 0, 0);
+            ++I;
+        }
+        else if(Value && strcmp(Arg, "-threads") == 0)
+        {
+            Settings.ThreadCount = strtoul(Value, 0, 0);
+            ++I;
+        }
+        else if(Value && strcmp(Arg, "-out") == 0)
+        {
+            Settings.OutputPrefix = Value;
+            ++I;
+        }
+        else
+        {
+            PrintUsage();
+            return(1);
+        }
+    }
+    if(Settings.RoomCount == 0 || Settings.AtlasColumns > 128 ||
+       Settings.MaxSolutionStates == 0 || Settings.MaxSolutionStates > MAX_SOLUTION_STATES)
+    {
+        PrintUsage();
+        return(1);
+    }
+    if(Settings.ThreadCount < 1)
+    {
+        Settings.ThreadCount = 1;
+    }
+    if(Settings.ThreadCount > 64)
+    {
+        Settings.ThreadCount = 64;
+    }
+    if(!HasSeed)
+    {
+        Settings.Seed = PATHS_FIRST_SEED;
+        for(u32 RoomsCleared = 1;
+            RoomsCleared <= Settings.FirstRoom;
+            ++RoomsCleared)
+        {
+            Settings.Seed = AdvanceRandomNumber(Settings.Seed + RoomsCleared);
+        }
+    }
+
+    if(Settings.VerifyBaked)
+    {
+        int MaxTiles = BakedMaxSize.Width * BakedMaxSize.Height;
+        game_tile *Tiles = (game_tile *)VirtualAlloc(0, 2 * MaxTiles * sizeof(game_tile), MEM_RESERVE|MEM_COMMIT, PAGE_READWRITE);
+        int Mismatches = VerifyBakedRooms(Tiles);
+        if(Mismatches)
+        {
+            fprintf(stderr, "%d of %d baked rooms differ from the generator.\n", Mismatches, PATHS_BAKED_ROOMS);
+        }
+        return(Mismatches ? 1 : 0);
+    }
+
+    InitializeCrc32Table();
+    work_queue Queue = {};
+    Queue.SemaphoreHandle = CreateSemaphoreEx(0, 0, Settings.ThreadCount, 0, 0, SEMAPHORE_ALL_ACCESS);
+    for(u32 I = 1;
+        I < Settings.ThreadCount;
+        ++I)
+    {
+        HANDLE ThreadHandle = CreateThread(0, 0, ThreadProc, &Queue, 0, 0);
+        CloseHandle(ThreadHandle);
+    }
+
+    // NOTE(Zyonji): rooms only grow, the last one bounds the memory of all others.
+    room_size MaxSize = GetRoomSize(Settings.FirstRoom + Settings.RoomCount - 1);
+    b32 Succeeded;
+    if(Settings.CountSolutions)
+    {
+        Succeeded = CountRoomSolutions(&Queue, &Settings, MaxSize);
+    }
+    else if(Settings.AtlasColumns)
+    {
+        Succeeded = ExportAtlas(&Queue, &Settings, MaxSize);
+    }
+    else
+    {
+        Succeeded = ExportRooms(&Queue, &Settings, MaxSize);
+    }
+
+    return(Succeeded ? 0 : 1);
+}